@@ -0,0 +1,140 @@
+/**********************************************************************************
+// Arena (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Alocador monotnico para memria temporria: reserva blocos
+//              grandes e entrega pedaos deles avanando um cursor, sem liberar
+//              nada individualmente. A memria volta a ser usada depois de Reset
+//              ou ao fim de um ArenaScope. Tambm  um std::pmr::memory_resource,
+//              de forma que contineres std::pmr podem alocar dentro da arena
+//
+**********************************************************************************/
+
+#include "Arena.h"
+#include <algorithm>
+#include <new>
+
+// -------------------------------------------------------------------------------
+
+Arena::Arena(size_t blockSize) : blockSize(blockSize), current(0), offset(0)
+{
+}
+
+// -------------------------------------------------------------------------------
+
+Arena::~Arena()
+{
+    for (Block& block : blocks)
+        ::operator delete(block.data);
+}
+
+// -------------------------------------------------------------------------------
+
+void* Arena::Allocate(size_t size, size_t alignment)
+{
+    if (size == 0)
+        size = 1;
+
+    // tenta o bloco atual e, em seguida, os blocos j reservados adiante
+    while (current < blocks.size())
+    {
+        Block& block = blocks[current];
+        size_t address = reinterpret_cast<size_t>(block.data) + offset;
+        size_t aligned = (address + alignment - 1) & ~(alignment - 1);
+        size_t end = aligned - reinterpret_cast<size_t>(block.data) + size;
+
+        if (end <= block.size)
+        {
+            offset = end;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        ++current;
+        offset = 0;
+    }
+
+    // nenhum bloco serve: reserva outro, grande o bastante para o pedido
+    Block block;
+    block.size = std::max(blockSize, size + alignment);
+    block.data = static_cast<byte*>(::operator new(block.size));
+    blocks.push_back(block);
+
+    current = uint(blocks.size() - 1);
+    offset = 0;
+
+    return Allocate(size, alignment);
+}
+
+// -------------------------------------------------------------------------------
+
+void Arena::Reset()
+{
+    current = 0;
+    offset = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+Arena::Marker Arena::Mark() const
+{
+    return { current, offset };
+}
+
+// -------------------------------------------------------------------------------
+
+void Arena::Rewind(Marker marker)
+{
+    current = marker.block;
+    offset = marker.offset;
+}
+
+// -------------------------------------------------------------------------------
+
+size_t Arena::Capacity() const
+{
+    size_t total = 0;
+    for (const Block& block : blocks)
+        total += block.size;
+    return total;
+}
+
+// -------------------------------------------------------------------------------
+
+uint Arena::BlockCount() const
+{
+    return uint(blocks.size());
+}
+
+// -------------------------------------------------------------------------------
+
+void* Arena::do_allocate(size_t bytes, size_t alignment)
+{
+    return Allocate(bytes, alignment);
+}
+
+// -------------------------------------------------------------------------------
+
+void Arena::do_deallocate(void*, size_t, size_t)
+{
+    // memria devolvida apenas por Reset ou Rewind
+}
+
+// -------------------------------------------------------------------------------
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+// -------------------------------------------------------------------------------
+
+Arena& ScratchArena()
+{
+    thread_local Arena arena(4 << 20);
+    return arena;
+}
+
+// -------------------------------------------------------------------------------
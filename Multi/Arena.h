@@ -0,0 +1,97 @@
+/**********************************************************************************
+// Arena (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Alocador monotnico para memria temporria: reserva blocos
+//              grandes e entrega pedaos deles avanando um cursor, sem liberar
+//              nada individualmente. A memria volta a ser usada depois de Reset
+//              ou ao fim de um ArenaScope. Tambm  um std::pmr::memory_resource,
+//              de forma que contineres std::pmr podem alocar dentro da arena
+//
+**********************************************************************************/
+
+#ifndef DXUT_ARENA_H_
+#define DXUT_ARENA_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// -------------------------------------------------------------------------------
+
+class Arena : public std::pmr::memory_resource
+{
+private:
+    struct Block
+    {
+        byte* data;                         // incio do bloco
+        size_t size;                        // tamanho do bloco em bytes
+    };
+
+    std::vector<Block> blocks;              // blocos reservados (mantidos entre usos)
+    size_t blockSize;                       // tamanho mnimo de um bloco novo
+    uint current;                           // bloco em uso
+    size_t offset;                          // primeira posio livre no bloco em uso
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+    // posio da arena, para devolver de uma vez tudo o que foi alocado depois dela
+    struct Marker
+    {
+        uint block;
+        size_t offset;
+    };
+
+    explicit Arena(size_t blockSize = 1 << 20);                             // construtor
+    ~Arena();                                                               // destrutor
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)); // reserva memria no inicializada
+    void Reset();                                                           // devolve toda a memria (mantm os blocos)
+
+    Marker Mark() const;                                                    // posio atual da arena
+    void Rewind(Marker marker);                                             // volta para uma posio anterior
+
+    size_t Capacity() const;                                                // bytes reservados em blocos
+    uint BlockCount() const;                                                // nmero de blocos reservados
+
+    template<class T>
+    T* Allocate(size_t count)                                               // reserva count elementos do tipo T
+    { return static_cast<T*>(Allocate(count * sizeof(T), alignof(T))); }
+};
+
+// -------------------------------------------------------------------------------
+
+// arena de rascunho da thread atual, usada pelas etapas de gerao e processamento
+Arena& ScratchArena();
+
+// devolve  arena, ao sair do escopo, tudo o que foi alocado dentro dele
+class ArenaScope
+{
+private:
+    Arena& arena;
+    Arena::Marker marker;
+
+public:
+    explicit ArenaScope(Arena& a) : arena(a), marker(a.Mark()) {}
+    ~ArenaScope() { arena.Rewind(marker); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+};
+
+// -------------------------------------------------------------------------------
+
+#endif
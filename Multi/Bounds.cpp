@@ -0,0 +1,295 @@
+/**********************************************************************************
+// Bounds (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Volumes envolventes de uma malha: caixa alinhada aos eixos,
+//              esfera de Ritter e caixa orientada pelos eixos principais (PCA).
+//              So calculados uma nica vez no espao do objeto e levados ao
+//              espao do mundo a cada quadro com poucas operaes vetoriais
+//
+**********************************************************************************/
+
+#include "Bounds.h"
+#include <cmath>
+
+// -------------------------------------------------------------------------------
+// Funes auxiliares
+
+// posio do vrtice v em um vetor intercalado
+static XMVECTOR LoadPosition(const float* positions, uint vertexStride, uint v)
+{
+    return XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(
+        reinterpret_cast<const byte*>(positions) + size_t(v) * vertexStride));
+}
+
+// mnimo e mximo das posies escritas na base dada (linhas da matriz so
+// os eixos); quatro acumuladores independentes evitam que cada iterao
+// espere pelo resultado da anterior
+static void MinMax(const float* positions, uint vertexCount, uint vertexStride,
+    FXMMATRIX basis, XMVECTOR& lo, XMVECTOR& hi)
+{
+    XMMATRIX toBasis = XMMatrixTranspose(basis);
+
+    XMVECTOR first = XMVector3TransformNormal(LoadPosition(positions, vertexStride, 0), toBasis);
+    XMVECTOR mins[4] = { first, first, first, first };
+    XMVECTOR maxs[4] = { first, first, first, first };
+
+    uint v = 0;
+    for (; v + 4 <= vertexCount; v += 4)
+    {
+        for (uint k = 0; k < 4; ++k)
+        {
+            XMVECTOR p = XMVector3TransformNormal(LoadPosition(positions, vertexStride, v + k), toBasis);
+            mins[k] = XMVectorMin(mins[k], p);
+            maxs[k] = XMVectorMax(maxs[k], p);
+        }
+    }
+
+    for (; v < vertexCount; ++v)
+    {
+        XMVECTOR p = XMVector3TransformNormal(LoadPosition(positions, vertexStride, v), toBasis);
+        mins[0] = XMVectorMin(mins[0], p);
+        maxs[0] = XMVectorMax(maxs[0], p);
+    }
+
+    lo = XMVectorMin(XMVectorMin(mins[0], mins[1]), XMVectorMin(mins[2], mins[3]));
+    hi = XMVectorMax(XMVectorMax(maxs[0], maxs[1]), XMVectorMax(maxs[2], maxs[3]));
+}
+
+// autovetores de uma matriz simtrica 3x3 pelo mtodo de Jacobi
+// (colunas de vectors, na ordem dos autovalores deixados na diagonal de a)
+static void Eigenvectors(double a[3][3], double vectors[3][3])
+{
+    for (uint i = 0; i < 3; ++i)
+        for (uint j = 0; j < 3; ++j)
+            vectors[i][j] = (i == j) ? 1.0 : 0.0;
+
+    for (uint sweep = 0; sweep < 32; ++sweep)
+    {
+        double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        if (off < 1e-20)
+            break;
+
+        for (uint p = 0; p < 2; ++p)
+        {
+            for (uint q = p + 1; q < 3; ++q)
+            {
+                if (fabs(a[p][q]) < 1e-30)
+                    continue;
+
+                // rotao que zera a[p][q]
+                double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                double t = (theta >= 0.0 ? 1.0 : -1.0) / (fabs(theta) + sqrt(theta * theta + 1.0));
+                double c = 1.0 / sqrt(t * t + 1.0);
+                double s = t * c;
+
+                for (uint k = 0; k < 3; ++k)
+                {
+                    double kp = a[k][p], kq = a[k][q];
+                    a[k][p] = c * kp - s * kq;
+                    a[k][q] = s * kp + c * kq;
+                }
+                for (uint k = 0; k < 3; ++k)
+                {
+                    double pk = a[p][k], qk = a[q][k];
+                    a[p][k] = c * pk - s * qk;
+                    a[q][k] = s * pk + c * qk;
+                }
+                for (uint k = 0; k < 3; ++k)
+                {
+                    double kp = vectors[k][p], kq = vectors[k][q];
+                    vectors[k][p] = c * kp - s * kq;
+                    vectors[k][q] = s * kp + c * kq;
+                }
+            }
+        }
+    }
+}
+
+// metade da rea da superfcie de uma caixa (aceita caixas achatadas)
+static float HalfArea(FXMVECTOR extents)
+{
+    float x = XMVectorGetX(extents), y = XMVectorGetY(extents), z = XMVectorGetZ(extents);
+    return x * y + y * z + z * x;
+}
+
+// -------------------------------------------------------------------------------
+
+Bounds ComputeBounds(const float* positions, uint vertexCount, uint vertexStride)
+{
+    Bounds bounds;
+
+    if (vertexCount == 0)
+        return bounds;
+
+    // caixa alinhada aos eixos
+    XMVECTOR boxMin, boxMax;
+    MinMax(positions, vertexCount, vertexStride, XMMatrixIdentity(), boxMin, boxMax);
+    XMStoreFloat3(&bounds.boxMin, boxMin);
+    XMStoreFloat3(&bounds.boxMax, boxMax);
+
+    // esfera de Ritter: dimetro inicial entre pontos distantes, depois cresce
+    // at conter todos os vrtices
+    XMVECTOR p0 = LoadPosition(positions, vertexStride, 0);
+    XMVECTOR p1 = p0;
+    float farthest = 0.0f;
+    for (uint v = 0; v < vertexCount; ++v)
+    {
+        XMVECTOR p = LoadPosition(positions, vertexStride, v);
+        float d = XMVectorGetX(XMVector3LengthSq(p - p0));
+        if (d > farthest) { farthest = d; p1 = p; }
+    }
+
+    XMVECTOR p2 = p1;
+    farthest = 0.0f;
+    for (uint v = 0; v < vertexCount; ++v)
+    {
+        XMVECTOR p = LoadPosition(positions, vertexStride, v);
+        float d = XMVectorGetX(XMVector3LengthSq(p - p1));
+        if (d > farthest) { farthest = d; p2 = p; }
+    }
+
+    XMVECTOR center = (p1 + p2) * 0.5f;
+    float radius = 0.5f * sqrtf(farthest);
+
+    // esfera centrada na caixa, que vence a de Ritter em formas simtricas
+    XMVECTOR boxCenter = (boxMin + boxMax) * 0.5f;
+    float boxRadius = 0.0f;
+
+    for (uint v = 0; v < vertexCount; ++v)
+    {
+        XMVECTOR p = LoadPosition(positions, vertexStride, v);
+        float d = XMVectorGetX(XMVector3Length(p - center));
+        if (d > radius)
+        {
+            float grown = 0.5f * (radius + d);
+            center += (p - center) * ((grown - radius) / d);
+            radius = grown;
+        }
+
+        boxRadius = fmaxf(boxRadius, XMVectorGetX(XMVector3Length(p - boxCenter)));
+    }
+
+    if (boxRadius < radius)
+    {
+        center = boxCenter;
+        radius = boxRadius;
+    }
+
+    XMStoreFloat3(&bounds.sphereCenter, center);
+    bounds.sphereRadius = radius;
+
+    // caixa orientada: eixos principais da covarincia das posies
+    double mean[3] = { 0.0, 0.0, 0.0 };
+    for (uint v = 0; v < vertexCount; ++v)
+    {
+        XMFLOAT3 p;
+        XMStoreFloat3(&p, LoadPosition(positions, vertexStride, v));
+        mean[0] += p.x; mean[1] += p.y; mean[2] += p.z;
+    }
+    for (uint i = 0; i < 3; ++i)
+        mean[i] /= vertexCount;
+
+    double covariance[3][3] = {};
+    for (uint v = 0; v < vertexCount; ++v)
+    {
+        XMFLOAT3 p;
+        XMStoreFloat3(&p, LoadPosition(positions, vertexStride, v));
+        double d[3] = { p.x - mean[0], p.y - mean[1], p.z - mean[2] };
+
+        for (uint i = 0; i < 3; ++i)
+            for (uint j = i; j < 3; ++j)
+                covariance[i][j] += d[i] * d[j];
+    }
+    for (uint i = 0; i < 3; ++i)
+        for (uint j = 0; j < i; ++j)
+            covariance[i][j] = covariance[j][i];
+
+    double vectors[3][3];
+    Eigenvectors(covariance, vectors);
+
+    XMVECTOR axis0 = XMVector3Normalize(XMVectorSet(float(vectors[0][0]), float(vectors[1][0]), float(vectors[2][0]), 0.0f));
+    XMVECTOR axis1 = XMVector3Normalize(XMVectorSet(float(vectors[0][1]), float(vectors[1][1]), float(vectors[2][1]), 0.0f));
+    XMVECTOR axis2 = XMVector3Normalize(XMVector3Cross(axis0, axis1));
+    axis1 = XMVector3Cross(axis2, axis0);
+
+    XMMATRIX basis = XMMatrixIdentity();
+    basis.r[0] = axis0;
+    basis.r[1] = axis1;
+    basis.r[2] = axis2;
+
+    XMVECTOR obbMin, obbMax;
+    MinMax(positions, vertexCount, vertexStride, basis, obbMin, obbMax);
+    XMVECTOR obbExtents = (obbMax - obbMin) * 0.5f;
+    XMVECTOR boxExtents = (boxMax - boxMin) * 0.5f;
+
+    // mantm a caixa alinhada quando ela j  mais justa que a orientada
+    if (HalfArea(boxExtents) <= HalfArea(obbExtents))
+    {
+        XMStoreFloat3(&bounds.obbCenter, boxCenter);
+        XMStoreFloat3(&bounds.obbExtents, boxExtents);
+    }
+    else
+    {
+        XMVECTOR obbCenter = XMVector3TransformNormal((obbMin + obbMax) * 0.5f, basis);
+        XMStoreFloat3(&bounds.obbCenter, obbCenter);
+        XMStoreFloat3(&bounds.obbExtents, obbExtents);
+        XMStoreFloat3(&bounds.obbAxes[0], axis0);
+        XMStoreFloat3(&bounds.obbAxes[1], axis1);
+        XMStoreFloat3(&bounds.obbAxes[2], axis2);
+    }
+
+    return bounds;
+}
+
+// -------------------------------------------------------------------------------
+
+Bounds TransformBounds(const Bounds& bounds, FXMMATRIX world)
+{
+    Bounds result;
+
+    // caixa alinhada: o centro  transformado e as meias dimenses so
+    // projetadas nos eixos do mundo pelos valores absolutos da matriz
+    XMVECTOR boxMin = XMLoadFloat3(&bounds.boxMin);
+    XMVECTOR boxMax = XMLoadFloat3(&bounds.boxMax);
+    XMVECTOR center = XMVector3Transform((boxMin + boxMax) * 0.5f, world);
+    XMVECTOR extents = (boxMax - boxMin) * 0.5f;
+
+    extents = XMVectorAbs(world.r[0]) * XMVectorSplatX(extents)
+            + XMVectorAbs(world.r[1]) * XMVectorSplatY(extents)
+            + XMVectorAbs(world.r[2]) * XMVectorSplatZ(extents);
+
+    XMStoreFloat3(&result.boxMin, center - extents);
+    XMStoreFloat3(&result.boxMax, center + extents);
+
+    // esfera: o raio cresce pela maior escala da matriz
+    XMVECTOR scale = XMVectorMax(XMVector3LengthSq(world.r[0]),
+        XMVectorMax(XMVector3LengthSq(world.r[1]), XMVector3LengthSq(world.r[2])));
+
+    XMStoreFloat3(&result.sphereCenter, XMVector3Transform(XMLoadFloat3(&bounds.sphereCenter), world));
+    result.sphereRadius = bounds.sphereRadius * sqrtf(XMVectorGetX(scale));
+
+    // caixa orientada: cada eixo  transformado e o seu comprimento
+    // passa para a meia dimenso correspondente
+    XMStoreFloat3(&result.obbCenter, XMVector3Transform(XMLoadFloat3(&bounds.obbCenter), world));
+
+    XMVECTOR axes[3];
+    for (uint i = 0; i < 3; ++i)
+        axes[i] = XMVector3TransformNormal(XMLoadFloat3(&bounds.obbAxes[i]), world);
+
+    XMVECTOR lengths = XMVectorSet(
+        XMVectorGetX(XMVector3Length(axes[0])),
+        XMVectorGetX(XMVector3Length(axes[1])),
+        XMVectorGetX(XMVector3Length(axes[2])), 0.0f);
+
+    XMStoreFloat3(&result.obbExtents, XMLoadFloat3(&bounds.obbExtents) * lengths);
+    for (uint i = 0; i < 3; ++i)
+        XMStoreFloat3(&result.obbAxes[i], XMVector3Normalize(axes[i]));
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,57 @@
+/**********************************************************************************
+// Bounds (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Volumes envolventes de uma malha: caixa alinhada aos eixos,
+//              esfera de Ritter e caixa orientada pelos eixos principais (PCA).
+//              So calculados uma nica vez no espao do objeto e levados ao
+//              espao do mundo a cada quadro com poucas operaes vetoriais
+//
+**********************************************************************************/
+
+#ifndef DXUT_BOUNDS_H_
+#define DXUT_BOUNDS_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <DirectXMath.h>
+using namespace DirectX;
+
+// -------------------------------------------------------------------------------
+
+struct Bounds
+{
+    XMFLOAT3 boxMin = { 0.0f, 0.0f, 0.0f };       // canto mnimo da caixa alinhada aos eixos
+    XMFLOAT3 boxMax = { 0.0f, 0.0f, 0.0f };       // canto mximo da caixa alinhada aos eixos
+
+    XMFLOAT3 sphereCenter = { 0.0f, 0.0f, 0.0f }; // centro da esfera envolvente
+    float sphereRadius = 0.0f;                    // raio da esfera envolvente
+
+    XMFLOAT3 obbCenter = { 0.0f, 0.0f, 0.0f };    // centro da caixa orientada
+    XMFLOAT3 obbExtents = { 0.0f, 0.0f, 0.0f };   // meias dimenses ao longo de cada eixo
+    XMFLOAT3 obbAxes[3] = {                       // eixos unitrios da caixa orientada
+        { 1.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f } };
+};
+
+// -------------------------------------------------------------------------------
+
+// calcula os trs volumes a partir das posies dos vrtices
+Bounds ComputeBounds(
+    const float* positions,                 // posio (x,y,z) do primeiro vrtice
+    uint vertexCount,                       // nmero de vrtices
+    uint vertexStride);                     // distncia em bytes entre posies
+
+// leva os volumes para o espao definido pela matriz (normalmente a de mundo):
+// a caixa alinhada continua envolvendo a original, a esfera cresce pela maior
+// escala e a caixa orientada s mantm os eixos ortogonais com escala uniforme
+Bounds TransformBounds(const Bounds& bounds, FXMMATRIX world);
+
+// -------------------------------------------------------------------------------
+
+#endif
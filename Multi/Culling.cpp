@@ -0,0 +1,240 @@
+/**********************************************************************************
+// Culling (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Caixas envolventes de mundo dos objetos guardadas em estrutura
+//              de arrays (centro e meias dimenses, um fluxo por componente).
+//              Todas as caixas so testadas contra os seis planos de cada vista
+//              ativa em uma nica passagem SIMD, que produz a lista de objetos
+//              visveis de cada vista
+//
+**********************************************************************************/
+
+#include "Culling.h"
+#include "Simd.h"
+#include <intrin.h>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+// -------------------------------------------------------------------------------
+
+const uint StreamAlignment = 64;            // alinhamento de cada fluxo (linha de cache, AVX-512)
+const uint StreamGranularity = 16;          // floats por fluxo mltiplo da maior largura SIMD
+const uint BoxStreams = 6;                  // centro (x,y,z) e meias dimenses (x,y,z)
+
+// plano com os valores absolutos da normal, usados no raio projetado da caixa
+struct CullPlane
+{
+    float a, b, c, d;                       // a x + b y + c z + d >= 0 no lado de dentro
+    float absA, absB, absC;                 // |a|, |b| e |c|
+};
+
+// -------------------------------------------------------------------------------
+
+// uma caixa est fora de uma vista se estiver inteira atrs de algum dos planos:
+// a distncia assinada do centro somada ao raio projetado da caixa  negativa
+template<class S>
+static void CullStreams(const float* const box[BoxStreams], const CullPlane planes[][6], 
+    const uint views[], uint viewCount, uint count, uint* const visible[], uint visibleCount[])
+{
+    using V = typename S::V;
+    const uint fullLanes = (1u << S::Width) - 1;
+
+    for (uint o = 0; o < count; o += S::Width)
+    {
+        V cx = S::Load(box[0] + o);
+        V cy = S::Load(box[1] + o);
+        V cz = S::Load(box[2] + o);
+        V ex = S::Load(box[3] + o);
+        V ey = S::Load(box[4] + o);
+        V ez = S::Load(box[5] + o);
+
+        // o ltimo lote pode passar de count: as posies extras so ignoradas
+        uint lanes = (count - o < S::Width) ? (1u << (count - o)) - 1 : fullLanes;
+
+        for (uint i = 0; i < viewCount; ++i)
+        {
+            uint v = views[i];
+            uint outside = 0;
+
+            for (uint p = 0; p < 6; ++p)
+            {
+                const CullPlane& plane = planes[v][p];
+
+                V distance = S::MulAdd(cx, S::Splat(plane.a), 
+                    S::MulAdd(cy, S::Splat(plane.b), S::MulAdd(cz, S::Splat(plane.c), S::Splat(plane.d))));
+
+                V radius = S::MulAdd(ex, S::Splat(plane.absA), 
+                    S::MulAdd(ey, S::Splat(plane.absB), S::Mul(ez, S::Splat(plane.absC))));
+
+                outside |= S::Negative(S::Add(distance, radius));
+            }
+
+            // ndices das posies visveis, do bit menos significativo ao mais
+            uint inside = ~outside & lanes;
+            uint* out = visible[v] + visibleCount[v];
+
+            while (inside)
+            {
+                unsigned long bit;
+                _BitScanForward(&bit, inside);
+                *out++ = o + bit;
+                inside &= inside - 1;
+            }
+
+            visibleCount[v] = uint(out - visible[v]);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+CullingStore::CullingStore()
+{
+}
+
+// -------------------------------------------------------------------------------
+
+CullingStore::~CullingStore()
+{
+    if (data)
+        ::operator delete(data, std::align_val_t(StreamAlignment));
+}
+
+// -------------------------------------------------------------------------------
+
+void CullingStore::Reserve(uint size)
+{
+    if (size <= capacity)
+        return;
+
+    // cresce em potncias de 2 para que Resize incremental seja amortizado
+    uint newCapacity = capacity ? capacity : StreamGranularity;
+    while (newCapacity < size)
+        newCapacity *= 2;
+
+    size_t bytes = size_t(newCapacity) * BoxStreams * sizeof(float);
+    float* newData = static_cast<float*>(::operator new(bytes, std::align_val_t(StreamAlignment)));
+
+    // o espao novo  zerado uma nica vez, de forma que os lotes SIMD 
+    // sempre leem valores vlidos alm da ltima caixa
+    for (uint s = 0; s < BoxStreams; ++s)
+    {
+        float* stream = newData + size_t(s) * newCapacity;
+        if (data)
+            memcpy(stream, Stream(s), size_t(count) * sizeof(float));
+
+        memset(stream + count, 0, size_t(newCapacity - count) * sizeof(float));
+    }
+
+    if (data)
+        ::operator delete(data, std::align_val_t(StreamAlignment));
+
+    data = newData;
+    capacity = newCapacity;
+}
+
+// -------------------------------------------------------------------------------
+
+void CullingStore::Resize(uint size)
+{
+    // chamado a cada quadro: sem mudana de tamanho, nada a fazer
+    if (size == count)
+        return;
+
+    Reserve(size);
+
+    // apenas as novas caixas so zeradas: o restante do fluxo j tem valores
+    // vlidos, da alocao ou de caixas removidas
+    if (size > count)
+    {
+        for (uint s = 0; s < BoxStreams; ++s)
+            memset(Stream(s) + count, 0, size_t(size - count) * sizeof(float));
+    }
+
+    count = size;
+}
+
+// -------------------------------------------------------------------------------
+
+void CullingStore::Set(uint index, const Bounds& world)
+{
+    Stream(0)[index] = 0.5f * (world.boxMin.x + world.boxMax.x);
+    Stream(1)[index] = 0.5f * (world.boxMin.y + world.boxMax.y);
+    Stream(2)[index] = 0.5f * (world.boxMin.z + world.boxMax.z);
+    Stream(3)[index] = 0.5f * (world.boxMax.x - world.boxMin.x);
+    Stream(4)[index] = 0.5f * (world.boxMax.y - world.boxMin.y);
+    Stream(5)[index] = 0.5f * (world.boxMax.z - world.boxMin.z);
+}
+
+// -------------------------------------------------------------------------------
+
+void CullingStore::Cull(const XMMATRIX viewProj[Views], const bool active[Views], vector<uint> visible[Views]) const
+{
+    CullPlane planes[Views][6];
+    uint views[Views];
+    uint viewCount = 0;
+
+    uint* lists[Views] = {};
+    uint listCounts[Views] = {};
+
+    for (uint v = 0; v < Views; ++v)
+    {
+        if (!active[v])
+            continue;
+
+        views[viewCount++] = v;
+
+        // planos tirados das colunas da view-projection (conveno de vetor-linha):
+        // um ponto est dentro se 0 <= z <= w e -w <= x,y <= w; o teste s usa o
+        // sinal, por isso os planos no precisam ser normalizados
+        XMMATRIX m = XMMatrixTranspose(viewProj[v]);
+        XMVECTOR sides[6] = 
+        { 
+            m.r[3] + m.r[0], m.r[3] - m.r[0],       // esquerda, direita
+            m.r[3] + m.r[1], m.r[3] - m.r[1],       // inferior, superior
+            m.r[2], m.r[3] - m.r[2]                 // prximo, distante
+        };
+
+        for (uint p = 0; p < 6; ++p)
+        {
+            XMFLOAT4 plane;
+            XMStoreFloat4(&plane, sides[p]);
+            planes[v][p] = { plane.x, plane.y, plane.z, plane.w, fabsf(plane.x), fabsf(plane.y), fabsf(plane.z) };
+        }
+
+        // espao para todos os objetos: o rascunho s cresce, e apenas os
+        // ndices visveis so copiados para a lista no fim
+        if (scratch[v].size() < count)
+            scratch[v].resize(count);
+        lists[v] = scratch[v].data();
+    }
+
+    if (count == 0)
+    {
+        for (uint i = 0; i < viewCount; ++i)
+            visible[views[i]].clear();
+        return;
+    }
+
+    const float* box[BoxStreams];
+    for (uint s = 0; s < BoxStreams; ++s)
+        box[s] = Stream(s);
+
+    // o fluxo tem capacidade mltipla de 16: o ltimo lote pode passar de count
+    switch (SimdLevel())
+    {
+    case SIMD_AVX512: CullStreams<SimdAvx512>(box, planes, views, viewCount, count, lists, listCounts); break;
+    case SIMD_AVX2:   CullStreams<SimdAvx2>(box, planes, views, viewCount, count, lists, listCounts); break;
+    default:          CullStreams<SimdSse>(box, planes, views, viewCount, count, lists, listCounts); break;
+    }
+
+    for (uint i = 0; i < viewCount; ++i)
+        visible[views[i]].assign(lists[views[i]], lists[views[i]] + listCounts[views[i]]);
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,67 @@
+/**********************************************************************************
+// Culling (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Caixas envolventes de mundo dos objetos guardadas em estrutura
+//              de arrays (centro e meias dimenses, um fluxo por componente).
+//              Todas as caixas so testadas contra os seis planos de cada vista
+//              ativa em uma nica passagem SIMD, que produz a lista de objetos
+//              visveis de cada vista
+//
+**********************************************************************************/
+
+#ifndef DXUT_CULLING_H_
+#define DXUT_CULLING_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include "Bounds.h"
+#include "Transforms.h"
+#include <vector>
+#include <DirectXMath.h>
+using namespace DirectX;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+class CullingStore
+{
+public:
+    static const uint Views = TransformStore::Views;
+
+private:
+    float* data = nullptr;                  // fluxos de centro (x,y,z) seguidos das meias dimenses (x,y,z)
+    uint count = 0;                         // caixas em uso
+    uint capacity = 0;                      // floats por fluxo (mltiplo de 16)
+    mutable vector<uint> scratch[Views];    // ndices escritos pela passagem SIMD
+
+    float* Stream(uint s) const             // incio de um fluxo
+    { return data + size_t(s) * capacity; }
+
+    void Reserve(uint size);                // garante espao para size caixas
+
+public:
+    CullingStore();                         // construtor
+    ~CullingStore();                        // destrutor
+
+    CullingStore(const CullingStore&) = delete;
+    CullingStore& operator=(const CullingStore&) = delete;
+
+    void Resize(uint size);                 // ajusta nmero de caixas (novas so vazias, na origem)
+    void Set(uint index, const Bounds& world);  // caixa alinhada de um volume no espao do mundo
+
+    // ndices das caixas que tocam o frustum de cada vista ativa; as listas
+    // das vistas inativas no so alteradas
+    void Cull(const XMMATRIX viewProj[Views], const bool active[Views], vector<uint> visible[Views]) const;
+
+    uint Count() const                      // nmero de caixas
+    { return count; }
+};
+
+// -------------------------------------------------------------------------------
+
+#endif
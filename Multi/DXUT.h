@@ -20,8 +20,16 @@
 #include "App.h"
 #include "Engine.h"
 #include "Error.h"
+#include "VertexInput.h"
 #include "Mesh.h"
 #include "Geometry.h"
+#include "Arena.h"
+#include "Terrain.h"
+#include "Transforms.h"
+#include "Culling.h"
+#include "SlotMap.h"
+#include "SceneGraph.h"
+#include "Profiler.h"
 #include "Object.h"
 
 // Cabealhos do DirectX 
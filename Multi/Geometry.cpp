@@ -10,23 +10,59 @@
 **********************************************************************************/
 
 #include "Geometry.h"
+#include "Arena.h"
+#include "Parallel.h"
+#include "Simplifier.h"
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
 
 //   __________   _____   __________   ________   ___________   ______   ______
 // _/ Geometry \_/ Box \_/ Cylinder \_/ Sphere \_/ GeoSphere \_/ Grid \_/ Quad \_
 // ------------------------------------------------------------------------------
 
+// descarta os meshlets depois de operaes que mudam a ordem ou a numerao dos
+// tringulos do nvel mais detalhado
+static void ClearMeshlets(Geometry& geo)
+{
+    geo.meshlets.clear();
+    geo.meshletVertices.clear();
+    geo.meshletTriangles.clear();
+    geo.meshletBounds.clear();
+    geo.meshletDraws.clear();
+}
+
+// refaz o fluxo de posies depois de operaes que criam ou movem vrtices
+// (o fluxo s  mantido quando BuildPositionStream j foi chamado)
+static void SyncPositions(Geometry& geo)
+{
+    if (!geo.positions.empty())
+        geo.BuildPositionStream();
+}
+
+// -------------------------------------------------------------------------------
+
 //   __________
 // _/ Geometry \_________________________________________________________________
 // ------------------------------------------------------------------------------
 
 void Geometry::Subdivide()
 {
-    // salva uma cpia da geometria original
-    vector <Vertex> verticesCopy = vertices;
-    vector <uint> indicesCopy = indices;
+    // a geometria original  trocada (e no copiada) para fora dos vetores
+    vector <Vertex> verticesCopy;
+    vector <uint> indicesCopy;
+    verticesCopy.swap(vertices);
+    indicesCopy.swap(indices);
+
+    // cada tringulo vira 6 vrtices e 4 tringulos: uma alocao por vetor
+    uint numTris = (uint)indicesCopy.size() / 3;
+    vertices.reserve(size_t(numTris) * 6);
+    indices.reserve(size_t(numTris) * 12);
 
-    vertices.resize(0);
-    indices.resize(0);
+    // nveis de detalhe e meshlets deixam de valer para a nova malha
+    lods.clear();
+    ClearMeshlets(*this);
 
     //       v1
     //       *
@@ -38,7 +74,6 @@ void Geometry::Subdivide()
     // *-----*-----*
     // v0    m2     v2
 
-    uint numTris = (uint)indicesCopy.size() / 3;
     for (uint i = 0; i < numTris; ++i)
     {
         Vertex v0 = verticesCopy[indicesCopy[size_t(i) * 3 + 0]];
@@ -75,6 +110,742 @@ void Geometry::Subdivide()
         indices.push_back(i * 6 + 1);
         indices.push_back(i * 6 + 4);
     }
+
+    SyncPositions(*this);
+}
+
+// -------------------------------------------------------------------------------
+// Funes auxiliares
+
+
+// valor hash para uma posio (zero negativo e positivo produzem o mesmo valor)
+static uint HashPosition(const XMFLOAT3& p)
+{
+    float f[3] = { p.x + 0.0f, p.y + 0.0f, p.z + 0.0f };
+    uint h[3];
+    memcpy(h, f, sizeof(h));
+
+    return (h[0] * 73856093u) ^ (h[1] * 19349663u) ^ (h[2] * 83492791u);
+}
+
+// -------------------------------------------------------------------------------
+
+// associa cada vrtice ao primeiro vrtice que ocupa a mesma posio,
+// usando uma tabela hash de endereamento aberto (sem alocaes por elemento)
+static void WeldPositions(const vector<Vertex>& vertices, std::pmr::vector<uint>& remap)
+{
+    uint count = uint(vertices.size());
+    remap.resize(count);
+
+    // tamanho da tabela  potncia de 2 com folga de pelo menos 25%
+    uint buckets = 1;
+    while (buckets < count + count / 4)
+        buckets *= 2;
+
+    std::pmr::vector<uint> table(buckets, UINT_MAX, remap.get_allocator());
+
+    for (uint i = 0; i < count; ++i)
+    {
+        const XMFLOAT3& p = vertices[i].pos;
+        uint slot = HashPosition(p) & (buckets - 1);
+
+        // sondagem linear at achar a posio ou um espao vazio
+        while (table[slot] != UINT_MAX)
+        {
+            const XMFLOAT3& q = vertices[table[slot]].pos;
+            if (p.x == q.x && p.y == q.y && p.z == q.z)
+                break;
+            slot = (slot + 1) & (buckets - 1);
+        }
+
+        if (table[slot] == UINT_MAX)
+            table[slot] = i;
+
+        remap[i] = table[slot];
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void Geometry::GenerateNormals(NormalModes mode, float creaseAngle)
+{
+    uint vertexCount = uint(vertices.size());
+    uint indexCount = uint(indices.size());
+    uint triCount = indexCount / 3;
+
+    // todos os vetores temporrios ficam na arena de rascunho da thread
+    // e so devolvidos de uma vez ao sair da funo
+    ArenaScope scope(ScratchArena());
+    std::pmr::memory_resource* scratch = &ScratchArena();
+
+    // vrtices com a mesma posio compartilham a vizinhana, de forma que costuras
+    // de textura, plos e malhas sem vrtices compartilhados (ex.: GeoSphere) 
+    // tambm recebem normais suaves
+    std::pmr::vector<uint> remap(scratch);
+    WeldPositions(vertices, remap);
+
+    // ---------------------------------------------------------
+    // Normais das faces e pesos dos cantos (paralelo por faixas)
+    // ---------------------------------------------------------
+
+    std::pmr::vector<XMFLOAT3> faceNormals(triCount, scratch);
+    std::pmr::vector<XMFLOAT3> cornerWeights(triCount, scratch);
+
+    ParallelFor(triCount, 16384, [&](uint begin, uint end)
+    {
+        for (uint t = begin; t < end; ++t)
+        {
+            XMVECTOR p0 = XMLoadFloat3(&vertices[indices[t * 3 + 0]].pos);
+            XMVECTOR p1 = XMLoadFloat3(&vertices[indices[t * 3 + 1]].pos);
+            XMVECTOR p2 = XMLoadFloat3(&vertices[indices[t * 3 + 2]].pos);
+
+            XMVECTOR e01 = p1 - p0;
+            XMVECTOR e12 = p2 - p1;
+            XMVECTOR e20 = p0 - p2;
+
+            // ordem dos vrtices segue a conveno horria do Direct3D
+            XMVECTOR n = XMVector3Cross(e01, -e20);
+            float doubleArea = XMVectorGetX(XMVector3Length(n));
+
+            // tringulos degenerados no contribuem para as normais
+            if (doubleArea <= 1e-20f)
+            {
+                faceNormals[t] = XMFLOAT3(0.0f, 0.0f, 0.0f);
+                cornerWeights[t] = XMFLOAT3(0.0f, 0.0f, 0.0f);
+                continue;
+            }
+
+            XMStoreFloat3(&faceNormals[t], n / doubleArea);
+
+            if (mode == AREA_WEIGHTED)
+            {
+                cornerWeights[t] = XMFLOAT3(doubleArea, doubleArea, doubleArea);
+            }
+            else
+            {
+                // ngulo interno em cada canto do tringulo
+                e01 = XMVector3Normalize(e01);
+                e12 = XMVector3Normalize(e12);
+                e20 = XMVector3Normalize(e20);
+
+                float a0 = XMScalarACos(XMVectorGetX(XMVector3Dot(e01, -e20)));
+                float a1 = XMScalarACos(XMVectorGetX(XMVector3Dot(e12, -e01)));
+                float a2 = XM_PI - a0 - a1;
+
+                cornerWeights[t] = XMFLOAT3(a0, a1, a2 > 0.0f ? a2 : 0.0f);
+            }
+        }
+    });
+
+    // --------------------------------------------------------
+    // Lista de cantos por posio (contagem + soma de prefixo)
+    // --------------------------------------------------------
+
+    std::pmr::vector<uint> offsets(size_t(vertexCount) + 1, 0, scratch);
+    for (uint c = 0; c < triCount * 3; ++c)
+        ++offsets[size_t(remap[indices[c]]) + 1];
+
+    for (uint v = 0; v < vertexCount; ++v)
+        offsets[size_t(v) + 1] += offsets[v];
+
+    std::pmr::vector<uint> corners(size_t(triCount) * 3, scratch);
+    std::pmr::vector<uint> cursor(offsets.begin(), offsets.end() - 1, scratch);
+    for (uint c = 0; c < triCount * 3; ++c)
+        corners[cursor[remap[indices[c]]]++] = c;
+
+    // contribuio ponderada de um canto para a normal do vrtice
+    auto Contribution = [&](uint corner)
+    {
+        const float* w = &cornerWeights[corner / 3].x;
+        return XMLoadFloat3(&faceNormals[corner / 3]) * w[corner % 3];
+    };
+
+    // ----------------------------------------------------------
+    // Normais suaves: cada vrtice soma apenas a sua vizinhana,
+    // ento as faixas paralelas no escrevem em posies comuns
+    // ----------------------------------------------------------
+
+    if (mode != CREASE_SPLIT)
+    {
+        ParallelFor(vertexCount, 16384, [&](uint begin, uint end)
+        {
+            for (uint v = begin; v < end; ++v)
+            {
+                uint group = remap[v];
+                XMVECTOR sum = XMVectorZero();
+
+                for (uint k = offsets[group]; k < offsets[size_t(group) + 1]; ++k)
+                    sum += Contribution(corners[k]);
+
+                XMStoreFloat3(&vertices[v].normal, XMVector3Normalize(sum));
+            }
+        });
+
+        return;
+    }
+
+    // ---------------------------------------------------------
+    // Vincos: cada canto soma apenas as faces cujo ngulo com a
+    // sua prpria face no ultrapassa o ngulo de vinco
+    // ---------------------------------------------------------
+
+    float cosCrease = cosf(creaseAngle);
+    std::pmr::vector<XMFLOAT3> cornerNormals(size_t(triCount) * 3, scratch);
+
+    ParallelFor(vertexCount, 16384, [&](uint begin, uint end)
+    {
+        for (uint v = begin; v < end; ++v)
+        {
+            // cada grupo de posio  processado uma nica vez
+            if (remap[v] != v)
+                continue;
+
+            for (uint a = offsets[v]; a < offsets[size_t(v) + 1]; ++a)
+            {
+                XMVECTOR na = XMLoadFloat3(&faceNormals[corners[a] / 3]);
+                XMVECTOR sum = XMVectorZero();
+
+                for (uint b = offsets[v]; b < offsets[size_t(v) + 1]; ++b)
+                {
+                    XMVECTOR nb = XMLoadFloat3(&faceNormals[corners[b] / 3]);
+                    if (XMVectorGetX(XMVector3Dot(na, nb)) >= cosCrease)
+                        sum += Contribution(corners[b]);
+                }
+
+                // face degenerada fica com a normal da prpria face (nula)
+                XMStoreFloat3(&cornerNormals[corners[a]], 
+                    XMVectorGetX(XMVector3LengthSq(sum)) > 0.0f ? XMVector3Normalize(sum) : na);
+            }
+        }
+    });
+
+    // ---------------------------------------------------------
+    // Diviso: um vrtice usado por cantos com normais distintas
+    //  duplicado apenas para as normais que ainda no possui
+    // ---------------------------------------------------------
+
+    // no pior caso cada canto ganha uma cpia: crescer dentro da arena
+    // deixaria para trs os blocos antigos at o fim da funo, por isso
+    // o espao  reservado antes da primeira alocao
+    std::pmr::vector<uint> nextCopy(scratch);
+    nextCopy.reserve(size_t(vertexCount) + size_t(triCount) * 3);
+    nextCopy.assign(vertexCount, UINT_MAX);
+
+    std::pmr::vector<bool> assigned(vertexCount, false, scratch);
+
+    // os ndices passam a apontar para as cpias
+    ClearMeshlets(*this);
+
+    for (uint c = 0; c < triCount * 3; ++c)
+    {
+        uint v = indices[c];
+        XMVECTOR n = XMLoadFloat3(&cornerNormals[c]);
+
+        if (!assigned[v])
+        {
+            XMStoreFloat3(&vertices[v].normal, n);
+            assigned[v] = true;
+            continue;
+        }
+
+        // percorre as cpias do vrtice procurando a mesma normal
+        uint u = v;
+        while (XMVectorGetX(XMVector3LengthSq(XMLoadFloat3(&vertices[u].normal) - n)) > 1e-6f)
+        {
+            if (nextCopy[u] == UINT_MAX)
+            {
+                Vertex copy = vertices[v];
+                XMStoreFloat3(&copy.normal, n);
+                vertices.push_back(copy);
+                nextCopy.push_back(UINT_MAX);
+                nextCopy[u] = uint(vertices.size() - 1);
+            }
+            u = nextCopy[u];
+        }
+
+        indices[c] = u;
+    }
+
+    // vrtices que no pertencem a nenhum tringulo ficam com normal nula
+    for (uint v = 0; v < vertexCount; ++v)
+        if (!assigned[v])
+            vertices[v].normal = XMFLOAT3(0.0f, 0.0f, 0.0f);
+
+    SyncPositions(*this);
+}
+
+// -------------------------------------------------------------------------------
+
+// faixas de ndices tratadas separadamente: uma por nvel de detalhe
+// ou a malha inteira enquanto GenerateLods no for chamado
+static vector<LodLevel> IndexRanges(const Geometry& geo)
+{
+    if (!geo.lods.empty())
+        return geo.lods;
+
+    LodLevel whole;
+    whole.indexCount = geo.IndexCount();
+    return { whole };
+}
+
+// -------------------------------------------------------------------------------
+
+void Geometry::GenerateLods(uint levels, float ratio)
+{
+    // recomea sempre a partir do nvel mais detalhado
+    if (!lods.empty())
+        indices.resize(lods[0].indexCount);
+
+    lods.clear();
+
+    uint baseCount = IndexCount();
+
+    LodLevel base;
+    base.indexCount = baseCount;
+    lods.push_back(base);
+
+    if (levels <= 1 || !PositionData())
+        return;
+
+    vector<vector<uint>> results(levels - 1);
+    vector<float> errors(levels - 1, 0.0f);
+
+    // cada nvel  simplificado a partir da malha original, 
+    // de forma que os nveis podem ser gerados em paralelo
+    ParallelFor(levels - 1, 1, [&](uint begin, uint end)
+    {
+        for (uint l = begin; l < end; ++l)
+        {
+            float fraction = powf(ratio, float(l + 1));
+            uint target = uint(baseCount / 3 * fraction) * 3;
+
+            results[l].resize(baseCount);
+            uint count = SimplifyMesh(results[l].data(), indices.data(), baseCount,
+                PositionData(), VertexCount(), PositionStride(), target, FLT_MAX, &errors[l]);
+            results[l].resize(count);
+        }
+    });
+
+    // nveis so concatenados depois do original no mesmo vetor de ndices
+    for (uint l = 0; l < levels - 1; ++l)
+    {
+        const LodLevel& previous = lods.back();
+        uint count = uint(results[l].size());
+
+        // nveis que quase no reduzem a malha no compensam
+        if (count == 0 || count > previous.indexCount / 10 * 9)
+            break;
+
+        LodLevel level;
+        level.startIndex = IndexCount();
+        level.indexCount = count;
+        level.error = (errors[l] > previous.error ? errors[l] : previous.error);
+
+        indices.insert(indices.end(), results[l].begin(), results[l].end());
+        lods.push_back(level);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void Geometry::OptimizeVertexCache()
+{
+    ClearMeshlets(*this);
+
+    for (const LodLevel& range : IndexRanges(*this))
+    {
+        uint* first = indices.data() + range.startIndex;
+        ::OptimizeVertexCache(first, first, range.indexCount, VertexCount());
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void Geometry::OptimizeOverdraw(float threshold)
+{
+    if (!PositionData())
+        return;
+
+    ClearMeshlets(*this);
+
+    for (const LodLevel& range : IndexRanges(*this))
+    {
+        uint* first = indices.data() + range.startIndex;
+        ::OptimizeOverdraw(first, first, range.indexCount, 
+            PositionData(), VertexCount(), PositionStride(), threshold);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void Geometry::OptimizeVertexFetch()
+{
+    vector<uint> remap(vertices.size());
+    uint used = GenerateFetchRemap(remap.data(), indices.data(), IndexCount(), VertexCount());
+
+    RemapIndexBuffer(indices.data(), indices.data(), IndexCount(), remap.data());
+    RemapVertexBuffer(vertices.data(), vertices.data(), VertexCount(), sizeof(Vertex), remap.data());
+    if (!positions.empty())
+        RemapVertexBuffer(positions.data(), positions.data(), VertexCount(), sizeof(XMFLOAT3), remap.data());
+
+    // vrtices dos meshlets acompanham a nova numerao
+    for (uint& v : meshletVertices)
+        v = remap[v];
+
+    // vrtices no referenciados ficaram no final do vetor
+    vertices.resize(used);
+    if (!positions.empty())
+        positions.resize(used);
+}
+
+// -------------------------------------------------------------------------------
+
+void Geometry::BuildMeshlets()
+{
+    ClearMeshlets(*this);
+
+    if (!PositionData())
+        return;
+
+    // meshlets cobrem apenas o nvel mais detalhado
+    uint count = lods.empty() ? IndexCount() : lods[0].indexCount;
+
+    ::BuildMeshlets(meshlets, meshletVertices, meshletTriangles, 
+        indices.data(), count, PositionData(), VertexCount(), PositionStride());
+
+    // ndices reescritos na ordem dos meshlets: cada meshlet passa a ser uma
+    // faixa contnua do index buffer, comeando em triangleOffset; dentro do
+    // meshlet os tringulos so reordenados para o cache de vrtices
+    uint local[MeshletMaxTriangles * 3];
+    uint write = 0;
+
+    for (const Meshlet& m : meshlets)
+    {
+        byte* triangles = &meshletTriangles[m.triangleOffset];
+        uint count = m.triangleCount * 3;
+
+        for (uint i = 0; i < count; ++i)
+            local[i] = triangles[i];
+
+        ::OptimizeVertexCache(local, local, count, m.vertexCount);
+
+        for (uint i = 0; i < count; ++i)
+        {
+            triangles[i] = byte(local[i]);
+            indices[write++] = meshletVertices[m.vertexOffset + local[i]];
+        }
+    }
+
+    meshletBounds.resize(meshlets.size());
+
+    ParallelFor(uint(meshlets.size()), 1024, [&](uint begin, uint end)
+    {
+        for (uint i = begin; i < end; ++i)
+            meshletBounds[i] = ComputeMeshletBounds(meshlets[i], meshletVertices.data(), 
+                meshletTriangles.data(), PositionData(), PositionStride());
+    });
+}
+
+// -------------------------------------------------------------------------------
+
+void Geometry::PackIndices()
+{
+    const uint Window = 65536;              // vrtices endereveis com 16 bits
+
+    indices16.clear();
+    submeshes.clear();
+    meshletDraws.clear();
+
+    vector<LodLevel> ranges = IndexRanges(*this);
+
+    // malhas pequenas cabem inteiras em ndices de 16 bits
+    if (VertexCount() <= Window)
+    {
+        indices16.assign(indices.begin(), indices.end());
+
+        for (LodLevel& range : ranges)
+        {
+            range.firstSubmesh = uint(submeshes.size());
+            range.submeshCount = 1;
+            submeshes.push_back({ range.indexCount, range.startIndex, 0 });
+        }
+
+        for (const Meshlet& m : meshlets)
+            meshletDraws.push_back({ m.triangleCount * 3, m.triangleOffset, 0 });
+    }
+    else
+    {
+        // malhas grandes so divididas em sub-malhas consecutivas com no mximo
+        // 65536 vrtices cada, numerados a partir do baseVertex da sub-malha; 
+        // vrtices usados por duas sub-malhas so duplicados na fronteira
+        vector<Vertex> packed;
+        packed.reserve(vertices.size() + vertices.size() / 32);
+
+        vector<uint> local(vertices.size(), UINT_MAX);      // ndice do vrtice na sub-malha
+        vector<uint> touched;                               // vrtices da sub-malha atual
+        indices16.resize(IndexCount());
+
+        for (uint r = 0; r < uint(ranges.size()); ++r)
+        {
+            LodLevel& range = ranges[r];
+
+            // cada nvel de detalhe comea uma nova sub-malha
+            for (uint v : touched)
+                local[v] = UINT_MAX;
+            touched.clear();
+
+            range.firstSubmesh = uint(submeshes.size());
+            SubMesh part = { 0, range.startIndex, uint(packed.size()) };
+
+            // unidades que no podem ser divididas entre sub-malhas: os meshlets
+            // no nvel mais detalhado e tringulos isolados nos demais casos
+            bool clustered = (r == 0 && !meshlets.empty());
+            uint unitCount = clustered ? uint(meshlets.size()) : range.indexCount / 3;
+
+            for (uint u = 0; u < unitCount; ++u)
+            {
+                uint first = clustered ? meshlets[u].triangleOffset : range.startIndex + u * 3;
+                uint count = clustered ? meshlets[u].triangleCount * 3 : 3;
+
+                // vrtices que a unidade acrescenta  sub-malha
+                uint needed = 0;
+                if (clustered)
+                    for (uint k = 0; k < meshlets[u].vertexCount; ++k)
+                        needed += (local[meshletVertices[meshlets[u].vertexOffset + k]] == UINT_MAX);
+                else
+                    for (uint i = first; i < first + 3; ++i)
+                        needed += (local[indices[i]] == UINT_MAX);
+
+                // sub-malha cheia: fecha e comea outra a partir do fim dos vrtices
+                if (uint(packed.size()) - part.baseVertex + needed > Window)
+                {
+                    submeshes.push_back(part);
+
+                    for (uint v : touched)
+                        local[v] = UINT_MAX;
+                    touched.clear();
+
+                    part = { 0, first, uint(packed.size()) };
+                }
+
+                for (uint i = first; i < first + count; ++i)
+                {
+                    uint v = indices[i];
+                    if (local[v] == UINT_MAX)
+                    {
+                        local[v] = uint(packed.size()) - part.baseVertex;
+                        packed.push_back(vertices[v]);
+                        touched.push_back(v);
+                    }
+
+                    // ndices de 32 bits continuam vlidos para o novo vetor de vrtices
+                    indices16[i] = ushort(local[v]);
+                    indices[i] = part.baseVertex + local[v];
+                }
+
+                part.indexCount += count;
+
+                // meshlets guardam a faixa de desenho e a nova numerao dos vrtices
+                if (clustered)
+                {
+                    meshletDraws.push_back({ count, first, part.baseVertex });
+
+                    uint* mv = &meshletVertices[meshlets[u].vertexOffset];
+                    for (uint k = 0; k < meshlets[u].vertexCount; ++k)
+                        mv[k] = part.baseVertex + local[mv[k]];
+                }
+            }
+
+            if (part.indexCount)
+                submeshes.push_back(part);
+
+            range.submeshCount = uint(submeshes.size()) - range.firstSubmesh;
+        }
+
+        vertices.swap(packed);
+    }
+
+    // guarda as sub-malhas de cada nvel
+    if (!lods.empty())
+        lods = ranges;
+
+    SyncPositions(*this);
+}
+
+// -------------------------------------------------------------------------------
+
+void Geometry::BuildPositionStream()
+{
+    positions.resize(vertices.size());
+    for (size_t v = 0; v < vertices.size(); ++v)
+        positions[v] = vertices[v].pos;
+}
+
+// -------------------------------------------------------------------------------
+
+void Geometry::ComputeBounds()
+{
+    if (!PositionData())
+        bounds = Bounds();
+    else
+        bounds = ::ComputeBounds(PositionData(), VertexCount(), PositionStride());
+}
+
+// -------------------------------------------------------------------------------
+
+SubMesh Geometry::Append(const Geometry& geo, FXMMATRIX world, uint level)
+{
+    // a malha combinada precisa ser otimizada e compactada de novo
+    if (!lods.empty())
+        indices.resize(lods[0].indexCount);
+
+    lods.clear();
+    indices16.clear();
+    submeshes.clear();
+    ClearMeshlets(*this);
+
+    // apenas o nvel escolhido da geometria acrescentada
+    uint first = 0;
+    uint count = geo.IndexCount();
+
+    if (!geo.lods.empty())
+    {
+        const LodLevel& range = geo.lods[level < geo.lods.size() ? level : geo.lods.size() - 1];
+        first = range.startIndex;
+        count = range.indexCount;
+    }
+
+    // s os vrtices usados pelo nvel so copiados, na ordem original
+    // (nveis de uma escada de tessellation tm vrtices prprios)
+    ArenaScope scope(ScratchArena());
+    std::pmr::vector<uint> remap(geo.vertices.size(), UINT_MAX, &ScratchArena());
+
+    for (uint i = first; i < first + count; ++i)
+        remap[geo.indices[i]] = 0;
+
+    uint baseVertex = VertexCount();
+    uint used = 0;
+    for (uint& r : remap)
+        if (r != UINT_MAX)
+            r = baseVertex + used++;
+
+    SubMesh part;
+    part.indexCount = count;
+    part.startIndex = IndexCount();
+    part.baseVertex = 0;
+
+    // normais usam a inversa transposta para suportar escala no uniforme
+    XMVECTOR det;
+    XMMATRIX normalMatrix = XMMatrixTranspose(XMMatrixInverse(&det, world));
+    bool mirrored = XMVectorGetX(det) < 0.0f;
+
+    vertices.reserve(vertices.size() + used);
+    for (size_t s = 0; s < geo.vertices.size(); ++s)
+    {
+        if (remap[s] == UINT_MAX)
+            continue;
+
+        const Vertex& source = geo.vertices[s];
+        Vertex v = source;
+        XMStoreFloat3(&v.pos, XMVector3Transform(XMLoadFloat3(&source.pos), world));
+        XMStoreFloat3(&v.normal, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&source.normal), normalMatrix)));
+        vertices.push_back(v);
+    }
+
+    // ndices absolutos; um espelhamento inverte a ordem dos vrtices
+    // de cada tringulo para manter as faces voltadas para fora
+    indices.reserve(indices.size() + count);
+    for (uint i = first; i < first + count; i += 3)
+    {
+        uint a = remap[geo.indices[i + 0]];
+        uint b = remap[geo.indices[i + 1]];
+        uint c = remap[geo.indices[i + 2]];
+
+        indices.push_back(a);
+        indices.push_back(mirrored ? c : b);
+        indices.push_back(mirrored ? b : c);
+    }
+
+    SyncPositions(*this);
+    return part;
+}
+
+// -------------------------------------------------------------------------------
+
+float Geometry::ACMR(uint cacheSize) const
+{
+    // mede o nvel mais detalhado
+    uint count = lods.empty() ? IndexCount() : lods[0].indexCount;
+    return ComputeACMR(indices.data(), count, VertexCount(), cacheSize);
+}
+
+// -------------------------------------------------------------------------------
+
+float Geometry::Overdraw() const
+{
+    if (!PositionData())
+        return 0.0f;
+
+    uint count = lods.empty() ? IndexCount() : lods[0].indexCount;
+    return ComputeOverdraw(indices.data(), count, 
+        PositionData(), VertexCount(), PositionStride());
+}
+
+// -------------------------------------------------------------------------------
+
+uint SelectLod(const vector<LodLevel>& lods, float pixelsPerUnit, float maxPixelError)
+{
+    // o erro cresce com o nvel: procura a partir do mais simples
+    for (uint i = uint(lods.size()); i > 1; --i)
+        if (lods[i - 1].error * pixelsPerUnit <= maxPixelError)
+            return i - 1;
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------------
+
+uint SelectLod(const vector<LodLevel>& lods, float pixelsPerUnit, float maxPixelError,
+    uint current, float hysteresis)
+{
+    if (current >= lods.size())
+        return SelectLod(lods, pixelsPerUnit, maxPixelError);
+
+    // nvel atual simples demais: volta ao nvel que atende o limite
+    if (lods[current].error * pixelsPerUnit > maxPixelError * (1.0f + hysteresis))
+        return SelectLod(lods, pixelsPerUnit, maxPixelError);
+
+    // nvel mais simples apenas com folga abaixo do limite
+    uint coarser = SelectLod(lods, pixelsPerUnit, maxPixelError * (1.0f - hysteresis));
+    return coarser > current ? coarser : current;
+}
+
+// -------------------------------------------------------------------------------
+
+uint CullMeshlets(vector<SubMesh>& visible, const vector<SubMesh>& draws, 
+    const vector<MeshletBounds>& bounds, const MeshletFrustum& frustum)
+{
+    visible.clear();
+    uint count = 0;
+
+    for (uint i = 0; i < uint(draws.size()); ++i)
+    {
+        if (!MeshletVisible(bounds[i], frustum))
+            continue;
+
+        ++count;
+        const SubMesh& draw = draws[i];
+
+        // meshlets vizinhos no index buffer viram um nico desenho
+        if (!visible.empty()
+            && visible.back().startIndex + visible.back().indexCount == draw.startIndex
+            && visible.back().baseVertex == draw.baseVertex)
+            visible.back().indexCount += draw.indexCount;
+        else
+            visible.push_back(draw);
+    }
+
+    return count;
 }
 
 //                _____
@@ -152,6 +923,10 @@ Cylinder::Cylinder(float bottom, float top, float height, uint sliceCount, uint
     // nmero de anis do cilindro
     uint ringCount = stackCount + 1;
 
+    // anis e tampas (borda mais centro) tm tamanho conhecido
+    vertices.reserve(size_t(ringCount) * (sliceCount + 1) + 2 * (size_t(sliceCount) + 2));
+    indices.reserve(size_t(stackCount) * sliceCount * 6 + size_t(sliceCount) * 6);
+
     // calcula vrtices de cada anel
     for (uint i = 0; i < ringCount; ++i)
     {
@@ -161,8 +936,9 @@ Cylinder::Cylinder(float bottom, float top, float height, uint sliceCount, uint
 
         for (uint j = 0; j <= sliceCount; ++j)
         {
-            float c = cosf(j * theta);
-            float s = sinf(j * theta);
+            // ltimo vrtice do anel repete exatamente a posio do primeiro
+            float c = cosf((j % sliceCount) * theta);
+            float s = sinf((j % sliceCount) * theta);
 
             Vertex vertex;
             vertex.pos = XMFLOAT3(r * c, y, r * s);
@@ -200,8 +976,8 @@ Cylinder::Cylinder(float bottom, float top, float height, uint sliceCount, uint
 
         for (uint i = 0; i <= sliceCount; i++)
         {
-            float x = r * cosf(i * theta);
-            float z = r * sinf(i * theta);
+            float x = r * cosf((i % sliceCount) * theta);
+            float z = r * sinf((i % sliceCount) * theta);
 
             vertex.pos = XMFLOAT3(x, y, z);
             vertex.color = XMFLOAT4(Colors::Yellow);
@@ -240,6 +1016,10 @@ Sphere::Sphere(float radius, uint sliceCount, uint stackCount)
     bottomVertex.pos = XMFLOAT3(0.0f, -radius, 0.0f);
     bottomVertex.color = XMFLOAT4(Colors::Yellow);
 
+    // plos, anis internos e camadas tm tamanho conhecido
+    vertices.reserve(2 + size_t(stackCount - 1) * (sliceCount + 1));
+    indices.reserve(size_t(sliceCount) * 6 + size_t(stackCount - 2) * sliceCount * 6);
+
     vertices.push_back(topVertex);
 
     float phiStep = XM_PI / stackCount;
@@ -253,7 +1033,8 @@ Sphere::Sphere(float radius, uint sliceCount, uint stackCount)
         // vrtices do anel
         for (uint j = 0; j <= sliceCount; ++j)
         {
-            float theta = j * thetaStep;
+            // ltimo vrtice do anel repete exatamente a posio do primeiro
+            float theta = (j % sliceCount) * thetaStep;
 
             Vertex v;
 
@@ -461,4 +1242,70 @@ Quad::Quad(float width, float height)
         indices.push_back(i);
 }
 
-// -------------------------------------------------------------------------------
\ No newline at end of file
+//                                                                   ________
+// _________________________________________________________________/ Ladder \_
+// ------------------------------------------------------------------------------
+
+// acrescenta uma tessellation completa como o prximo nvel de detalhe
+static void AppendLevel(Geometry& ladder, Geometry& level, float error)
+{
+    level.GenerateNormals();
+
+    LodLevel lod;
+    lod.startIndex = ladder.IndexCount();
+    lod.indexCount = level.IndexCount();
+    lod.error = error;
+    ladder.lods.push_back(lod);
+
+    uint baseVertex = ladder.VertexCount();
+    ladder.vertices.insert(ladder.vertices.end(), level.vertices.begin(), level.vertices.end());
+
+    ladder.indices.reserve(ladder.indices.size() + level.indices.size());
+    for (uint i : level.indices)
+        ladder.indices.push_back(baseVertex + i);
+}
+
+// nmero de fatias do prximo degrau: cerca de 2/3 do anterior, 
+// de forma que o nmero de tringulos cai pela metade a cada nvel
+static uint NextSlices(uint slices, uint minSlices)
+{
+    uint next = slices * 2 / 3;
+    return next > minSlices ? next : minSlices;
+}
+
+// -------------------------------------------------------------------------------
+
+SphereLadder::SphereLadder(float radius, uint maxSlices, uint minSlices)
+{
+    for (uint slices = maxSlices; ; slices = NextSlices(slices, minSlices))
+    {
+        // camadas e fatias cobrem o mesmo ngulo: o centro de cada face
+        // fica afastado da esfera em cerca de r (1 - cos^2(pi / fatias))
+        Sphere level(radius, slices, slices / 2 > 2 ? slices / 2 : 2);
+        float c = cosf(XM_PI / slices);
+        AppendLevel(*this, level, radius * (1.0f - c * c));
+
+        if (slices <= minSlices)
+            break;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+CylinderLadder::CylinderLadder(float bottom, float top, float height, uint maxSlices, uint minSlices)
+{
+    float radius = bottom > top ? bottom : top;
+
+    for (uint slices = maxSlices; ; slices = NextSlices(slices, minSlices))
+    {
+        // a lateral  reta entre as tampas: uma nica camada basta e
+        // o erro  a flecha de cada fatia no maior raio
+        Cylinder level(bottom, top, height, slices, 1);
+        AppendLevel(*this, level, radius * (1.0f - cosf(XM_PI / slices)));
+
+        if (slices <= minSlices)
+            break;
+    }
+}
+
+// -------------------------------------------------------------------------------
@@ -15,7 +15,12 @@
 // -------------------------------------------------------------------------------
 
 #include "Types.h"
+#include "Optimizer.h"
+#include "Meshlet.h"
+#include "Bounds.h"
+#include "VertexTypes.h"
 #include <vector>
+#include <dxgiformat.h>
 #include <DirectXMath.h>
 #include <DirectXColors.h>
 using namespace DirectX;
@@ -23,10 +28,46 @@ using std::vector;
 
 // -------------------------------------------------------------------------------
 
-struct Vertex
+struct SubMesh
 {
-    XMFLOAT3 pos;
-    XMFLOAT4 color;
+    uint indexCount = 0;
+    uint startIndex = 0;
+    uint baseVertex = 0;
+};
+
+// -------------------------------------------------------------------------------
+
+struct LodLevel
+{
+    uint startIndex = 0;                    // primeiro ndice do nvel
+    uint indexCount = 0;                    // nmero de ndices do nvel
+    uint firstSubmesh = 0;                  // primeira sub-malha do nvel (PackIndices)
+    uint submeshCount = 0;                  // nmero de sub-malhas do nvel (PackIndices)
+    float error = 0.0f;                     // erro geomtrico no espao do objeto
+};
+
+// escolhe o nvel mais simples cujo erro projetado na tela no passa de
+// maxPixelError, dado o nmero de pixels ocupados por uma unidade do objeto
+uint SelectLod(const vector<LodLevel>& lods, float pixelsPerUnit, float maxPixelError = 1.0f);
+
+// mesma escolha com histerese a partir do nvel atual: troca por um nvel mais
+// detalhado s quando o erro passa de maxPixelError * (1 + hysteresis) e por um
+// mais simples s quando o erro fica abaixo de maxPixelError * (1 - hysteresis)
+uint SelectLod(const vector<LodLevel>& lods, float pixelsPerUnit, float maxPixelError, 
+    uint current, float hysteresis = 0.25f);
+
+// grava em visible as faixas de ndices dos meshlets que passam pelo descarte,
+// unindo faixas vizinhas em um nico desenho; retorna o nmero de meshlets visveis
+uint CullMeshlets(vector<SubMesh>& visible, const vector<SubMesh>& draws, 
+    const vector<MeshletBounds>& bounds, const MeshletFrustum& frustum);
+
+// -------------------------------------------------------------------------------
+
+enum NormalModes
+{
+    AREA_WEIGHTED,                          // mdia das faces ponderada pela rea
+    ANGLE_WEIGHTED,                         // mdia das faces ponderada pelo ngulo do canto
+    CREASE_SPLIT                            // duplica vrtices em arestas vivas (vincos)
 };
 
 // -------------------------------------------------------------------------------
@@ -37,9 +78,53 @@ struct Geometry
 {
     vector<Vertex> vertices;                // vrtices da geometria
     vector<uint>   indices;                 // ndices da geometria
+    vector<XMFLOAT3> positions;             // cpia compacta das posies (BuildPositionStream)
+    vector<ushort> indices16;               // ndices de 16 bits gerados por PackIndices
+    vector<SubMesh> submeshes;              // faixas de desenho geradas por PackIndices
+    vector<LodLevel> lods;                  // nveis de detalhe gerados por GenerateLods
+
+    vector<Meshlet> meshlets;               // meshlets do nvel mais detalhado
+    vector<uint> meshletVertices;           // vrtices de cada meshlet
+    vector<byte> meshletTriangles;          // tringulos de cada meshlet (ndices locais)
+    vector<MeshletBounds> meshletBounds;    // esfera e cone de normais de cada meshlet
+    vector<SubMesh> meshletDraws;           // faixa do index buffer de cada meshlet (PackIndices)
+    Bounds bounds;                          // volumes envolventes gerados por ComputeBounds
 
     void Subdivide();                       // subdivide tringulos
 
+    void GenerateNormals(                   // calcula normais dos vrtices
+        NormalModes mode = CREASE_SPLIT,    // modo de clculo das normais
+        float creaseAngle = XM_PI / 3.0f);  // ngulo mximo entre faces suavizadas
+
+    void GenerateLods(                      // acrescenta nveis de detalhe simplificados
+        uint levels = 4,                    // nmero de nveis (incluindo o original)
+        float ratio = 0.5f);                // frao de tringulos mantida a cada nvel
+
+    void OptimizeVertexCache();             // reordena tringulos para o cache de vrtices
+    void OptimizeOverdraw(                  // ordena blocos de tringulos para reduzir overdraw
+        float threshold = 1.05f);           // perda mxima de ACMR aceita
+    void OptimizeVertexFetch();             // reordena vrtices na ordem de uso dos ndices
+    float ACMR(                             // falhas no cache de vrtices por tringulo
+        uint cacheSize = VertexCacheSize) const;
+    float Overdraw() const;                 // estimativa de overdraw feita na CPU
+
+    void BuildMeshlets();                   // agrupa tringulos em meshlets (aps cache e overdraw)
+
+    void PackIndices();                     // converte ndices para 16 bits (divide malhas grandes)
+
+    void BuildPositionStream();             // mantm as posies tambm em um vetor compacto
+    void ComputeBounds();                   // calcula caixa, esfera e caixa orientada dos vrtices
+
+    template<class VertexT>
+    void PackVertices(                      // converte vrtices para o tipo usado no vertex buffer
+        vector<VertexT>& data,              // vrtices convertidos
+        XMFLOAT4X4& dequantize) const;      // matriz que leva as posies ao espao do objeto
+
+    SubMesh Append(                         // acrescenta outra geometria aos mesmos buffers
+        const Geometry& geo,                // geometria acrescentada
+        FXMMATRIX world = XMMatrixIdentity(), // transformao aplicada aos vrtices copiados
+        uint level = 0);                    // nvel de detalhe copiado (apenas os seus vrtices)
+
     // mtodos inline
     const Vertex* VertexData() const        // retorna vrtices da geometria
     { return vertices.data(); }
@@ -52,8 +137,65 @@ struct Geometry
     
     uint IndexCount() const                 // retorna nmero de ndices
     { return uint(indices.size()); }
+
+    // posies lidas pelas passagens na CPU: o vetor compacto quando existe
+    // (12 bytes por vrtice), as posies intercaladas em Vertex ou nullptr
+    // em uma geometria vazia (um .obj que no pde ser lido, por exemplo)
+    const float* PositionData() const       // retorna posio do primeiro vrtice
+    { return !positions.empty() ? &positions[0].x : vertices.empty() ? nullptr : &vertices[0].pos.x; }
+
+    uint PositionStride() const             // retorna distncia em bytes entre posies
+    { return positions.empty() ? uint(sizeof(Vertex)) : uint(sizeof(XMFLOAT3)); }
+
+    // buffer de ndices no formato escolhido por PackIndices
+    // (ndices de 32 bits enquanto PackIndices no for chamado)
+    const void* IndexBufferData() const     // retorna ndices para o index buffer
+    { return indices16.empty() ? (const void*) indices.data() : indices16.data(); }
+
+    uint IndexBufferSize() const            // retorna tamanho do index buffer em bytes
+    { return indices16.empty() ? IndexCount() * sizeof(uint) : IndexCount() * sizeof(ushort); }
+
+    DXGI_FORMAT IndexFormat() const         // retorna formato do index buffer
+    { return indices16.empty() ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT; }
 };
 
+// -------------------------------------------------------------------------------
+
+template<class VertexT>
+void Geometry::PackVertices(vector<VertexT>& data, XMFLOAT4X4& dequantize) const
+{
+    using Descriptor = VertexDescriptor<VertexT>;
+
+    XMVECTOR center = XMVectorZero();
+    XMVECTOR extent = XMVectorSplatOne();
+
+    // posies quantizadas dentro da caixa envolvente: [-1,1] em cada eixo
+    if (Descriptor::quantized && !vertices.empty())
+    {
+        XMVECTOR lo = XMLoadFloat3(&vertices[0].pos);
+        XMVECTOR hi = lo;
+        for (const Vertex& v : vertices)
+        {
+            lo = XMVectorMin(lo, XMLoadFloat3(&v.pos));
+            hi = XMVectorMax(hi, XMLoadFloat3(&v.pos));
+        }
+
+        center = (lo + hi) * 0.5f;
+        extent = XMVectorMax((hi - lo) * 0.5f, XMVectorReplicate(1e-6f));
+    }
+
+    // a volta ao espao do objeto entra na matriz combinada, sem custo no shader
+    XMStoreFloat4x4(&dequantize,
+        XMMatrixScaling(XMVectorGetX(extent), XMVectorGetY(extent), XMVectorGetZ(extent)) *
+        XMMatrixTranslation(XMVectorGetX(center), XMVectorGetY(center), XMVectorGetZ(center)));
+
+    XMVECTOR inverseExtent = XMVectorReciprocal(extent);
+
+    data.resize(vertices.size());
+    for (size_t v = 0; v < vertices.size(); ++v)
+        data[v] = Descriptor::Encode(vertices[v], center, inverseExtent);
+}
+
 // -------------------------------------------------------------------------------
 // Box
 // -------------------------------------------------------------------------------
@@ -109,6 +251,23 @@ struct Quad : public Geometry
     Quad(float width, float height);
 };
 
+// -------------------------------------------------------------------------------
+// Escadas de tessellation: cada nvel de detalhe (lods)  a primitiva inteira
+// gerada com menos fatias, do mais detalhado ao mais simples, com o erro igual
+//  distncia mxima entre as faces e a superfcie exata; os nveis j vm com
+// normais e GenerateLods no deve ser chamado
+// -------------------------------------------------------------------------------
+
+struct SphereLadder : public Geometry
+{
+    SphereLadder(float radius, uint maxSlices = 96, uint minSlices = 8);
+};
+
+struct CylinderLadder : public Geometry
+{
+    CylinderLadder(float bottom, float top, float height, uint maxSlices = 96, uint minSlices = 8);
+};
+
 // -------------------------------------------------------------------------------
 
 #endif
@@ -52,6 +52,9 @@ Graphics::Graphics()
     fence = nullptr;
     fenceEvent = nullptr;
     fenceValue = 0;
+
+    // cpias agrupadas
+    batching = false;
 }
 
 // ------------------------------------------------------------------------------
@@ -61,6 +64,10 @@ Graphics::~Graphics()
     // espera GPU finalizar comandos na fila
     WaitCommandQueue();
 
+    // libera buffers de upload de cpias agrupadas
+    for (ID3D12Resource* upload : retired)
+        upload->Release();
+
     // libera depth stencil buffer
     if (depthStencil)
         depthStencil->Release();
@@ -563,6 +570,11 @@ void Graphics::SubmitCommands()
 
     // espera at a GPU completar a execuo dos comandos
     WaitCommandQueue();
+
+    // as cpias agrupadas j foram executadas: seus buffers de upload podem sair
+    for (ID3D12Resource* upload : retired)
+        upload->Release();
+    retired.clear();
 }
 
 // -----------------------------------------------------------------------------
@@ -624,6 +636,17 @@ void Graphics::Copy(const void* vertices, uint sizeInBytes, ID3D12Resource* buff
     //
     // ----------------------------------------------------------------------------------
 
+    // cpias agrupadas: os dados so guardados e gravados de uma vez em EndUpload
+    if (batching)
+    {
+        // incio de cada cpia alinhado para o memcpy e para a leitura pela GPU
+        uint offset = uint((staging.size() + 15) & ~size_t(15));
+        staging.resize(size_t(offset) + sizeInBytes);
+        memcpy(staging.data() + offset, vertices, sizeInBytes);
+        pending.push_back({ bufferGPU, offset, sizeInBytes });
+        return;
+    }
+
     // descreve os dados que sero copiados
     D3D12_SUBRESOURCE_DATA vertexSubResourceData = {};
     vertexSubResourceData.pData = vertices;
@@ -714,6 +737,61 @@ void Graphics::Copy(const void* vertices, uint sizeInBytes, ID3D12Resource* buff
 
 // -----------------------------------------------------------------------------
 
+void Graphics::BeginUpload()
+{
+    batching = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void Graphics::EndUpload()
+{
+    batching = false;
+
+    if (pending.empty())
+        return;
+
+    // um nico buffer de upload para todas as cpias agrupadas
+    ID3D12Resource* upload = nullptr;
+    Allocate(UPLOAD, uint(staging.size()), &upload);
+
+    BYTE* pData;
+    upload->Map(0, nullptr, (void**)&pData);
+    memcpy(pData, staging.data(), staging.size());
+    upload->Unmap(0, nullptr);
+
+    // todas as transies de estado de cada lado das cpias em uma s chamada
+    vector<D3D12_RESOURCE_BARRIER> barriers(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        barriers[i].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barriers[i].Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        barriers[i].Transition.pResource = pending[i].destination;
+        barriers[i].Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
+        barriers[i].Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
+        barriers[i].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    }
+    commandList->ResourceBarrier(uint(barriers.size()), barriers.data());
+
+    for (const PendingCopy& copy : pending)
+        commandList->CopyBufferRegion(copy.destination, 0, upload, copy.offset, copy.size);
+
+    for (D3D12_RESOURCE_BARRIER& barrier : barriers)
+    {
+        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
+    }
+    commandList->ResourceBarrier(uint(barriers.size()), barriers.data());
+
+    // o buffer de upload precisa existir at a GPU executar as cpias
+    retired.push_back(upload);
+
+    staging.clear();
+    pending.clear();
+}
+
+// -----------------------------------------------------------------------------
+
 void Graphics::Present()
 {
     // indica que o backbuffer ser usado para apresentao
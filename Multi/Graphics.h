@@ -20,6 +20,8 @@
 #include "Window.h"              // cria e configura uma janela do Windows
 #include "Types.h"               // tipos especficos da engine
 #include <D3DCompiler.h>         // fornece D3DBlob
+#include <vector>                // cpias agrupadas
+using std::vector;
 
 enum AllocationType { GPU, UPLOAD, CBUFFER };
 
@@ -58,6 +60,19 @@ private:
     HANDLE                       fenceEvent;                // sinalizador de eventos
     ullong                       fenceValue;				// nmero atual da barreira
 
+    // cpias agrupadas
+    struct PendingCopy
+    {
+        ID3D12Resource         * destination;               // buffer na GPU
+        uint                     offset;                    // posio dos dados no buffer de upload
+        uint                     size;                      // tamanho dos dados
+    };
+
+    bool                         batching;                  // cpias acumuladas at EndUpload
+    vector<byte>                 staging;                   // dados das cpias acumuladas
+    vector<PendingCopy>          pending;                   // cpias acumuladas
+    vector<ID3D12Resource*>      retired;                   // buffers de upload liberados aps a prxima submisso
+
     // mtodos privados
     void LogHardwareInfo();                                 // mostra informaes do hardware
     bool WaitCommandQueue();                                // espera execuo da fila de comandos
@@ -83,6 +98,10 @@ public:
               ID3D12Resource* bufferUpload,
               ID3D12Resource* bufferGPU);                   // copia vrtices para a GPU
 
+    void BeginUpload();                                     // passa a agrupar as cpias em um nico buffer de upload
+    void EndUpload();                                       // grava as cpias agrupadas na lista de comandos
+    bool Uploading();                                       // cpias esto sendo agrupadas
+
     ID3D12Device9* Device();                                // retorna dispositivo Direct3D
     ID3D12GraphicsCommandList* CommandList();               // retorna lista de comandos
     uint Antialiasing();                                    // retorna nmero de amostras por pixel
@@ -104,6 +123,10 @@ inline ID3D12Device9* Graphics::Device()
 inline ID3D12GraphicsCommandList* Graphics::CommandList()
 { return commandList; }
 
+// cpias esto sendo agrupadas (buffers de upload individuais so dispensveis)
+inline bool Graphics::Uploading()
+{ return batching; }
+
 // retorna nmero de amostras por pixel
 inline uint Graphics::Antialiasing()
 { return antialiasing; }
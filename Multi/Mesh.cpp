@@ -22,6 +22,13 @@ Mesh::Mesh()
     vertexBufferSize = 0;
     vertexBufferStride = 0;
 
+    positionBufferUpload = nullptr;
+    positionBufferGPU = nullptr;
+    ZeroMemory(&positionBufferView, sizeof(D3D12_VERTEX_BUFFER_VIEW));
+    positionBufferSize = 0;
+    positionBufferStride = 0;
+    ZeroMemory(streamViews, sizeof(streamViews));
+
     indexBufferUpload = nullptr;
     indexBufferGPU = nullptr;
     ZeroMemory(&indexBufferView, sizeof(D3D12_INDEX_BUFFER_VIEW));
@@ -33,6 +40,8 @@ Mesh::Mesh()
     cbufferData = nullptr;
     cbufferDescriptorSize = 0;
     cbufferElementSize = 0;
+
+    XMStoreFloat4x4(&dequantize, XMMatrixIdentity());
 }
 
 // -------------------------------------------------------------------------------
@@ -41,6 +50,8 @@ Mesh::~Mesh()
 {
     if (vertexBufferUpload) vertexBufferUpload->Release();
     if (vertexBufferGPU) vertexBufferGPU->Release();
+    if (positionBufferUpload) positionBufferUpload->Release();
+    if (positionBufferGPU) positionBufferGPU->Release();
     if (indexBufferUpload) indexBufferUpload->Release();
     if (indexBufferGPU) indexBufferGPU->Release();
 
@@ -60,8 +71,10 @@ void Mesh::VertexBuffer(const void* vb, uint vbSize, uint vbStride)
     vertexBufferSize = vbSize;
     vertexBufferStride = vbStride;
 
-    // aloca recursos para o vertex buffer
-    Engine::graphics->Allocate(UPLOAD, vbSize, &vertexBufferUpload);
+    // aloca recursos para o vertex buffer (cpias agrupadas
+    // usam o buffer de upload compartilhado da Graphics)
+    if (!Engine::graphics->Uploading())
+        Engine::graphics->Allocate(UPLOAD, vbSize, &vertexBufferUpload);
     Engine::graphics->Allocate(GPU, vbSize, &vertexBufferGPU);
 
     // copia vrtices para o buffer da GPU usando o buffer de Upload
@@ -70,6 +83,55 @@ void Mesh::VertexBuffer(const void* vb, uint vbSize, uint vbStride)
 
 // -------------------------------------------------------------------------------
 
+void Mesh::PositionBuffer(const void* pb, uint pbSize, uint pbStride)
+{
+    // guarda tamanho do buffer e da posio
+    positionBufferSize = pbSize;
+    positionBufferStride = pbStride;
+
+    // aloca recursos para o buffer de posies
+    if (!Engine::graphics->Uploading())
+        Engine::graphics->Allocate(UPLOAD, pbSize, &positionBufferUpload);
+    Engine::graphics->Allocate(GPU, pbSize, &positionBufferGPU);
+
+    // copia posies para o buffer da GPU usando o buffer de Upload
+    Engine::graphics->Copy(pb, pbSize, positionBufferUpload, positionBufferGPU);
+}
+
+// -------------------------------------------------------------------------------
+
+void Mesh::VertexBuffer(const void* vb, uint vbCount, uint vbStride, uint positionSize, bool splitPositions)
+{
+    if (!splitPositions)
+    {
+        VertexBuffer(vb, vbCount * vbStride, vbStride);
+        return;
+    }
+
+    // separa cada vrtice em posio (incio do vrtice) e demais atributos,
+    // de forma que passagens que s usam posies leiam apenas o primeiro buffer
+    const byte* data = static_cast<const byte*>(vb);
+    uint attributeStride = vbStride - positionSize;
+
+    vector<byte> positionData(size_t(vbCount) * positionSize);
+    vector<byte> attributeData(size_t(vbCount) * attributeStride);
+
+    for (uint v = 0; v < vbCount; ++v)
+    {
+        const byte* source = data + size_t(v) * vbStride;
+        memcpy(&positionData[size_t(v) * positionSize], source, positionSize);
+        memcpy(&attributeData[size_t(v) * attributeStride], source + positionSize, attributeStride);
+    }
+
+    PositionBuffer(positionData.data(), uint(positionData.size()), positionSize);
+
+    // vrtices s com posio no tm fluxo de atributos
+    if (attributeStride)
+        VertexBuffer(attributeData.data(), uint(attributeData.size()), attributeStride);
+}
+
+// -------------------------------------------------------------------------------
+
 void Mesh::IndexBuffer(const void* ib, uint ibSize, DXGI_FORMAT ibFormat)
 {
     // guarda tamanho do buffer e formato dos ndices
@@ -77,7 +139,8 @@ void Mesh::IndexBuffer(const void* ib, uint ibSize, DXGI_FORMAT ibFormat)
     indexFormat = ibFormat;
 
     // aloca recursos para o index buffer
-    Engine::graphics->Allocate(UPLOAD, ibSize, &indexBufferUpload);
+    if (!Engine::graphics->Uploading())
+        Engine::graphics->Allocate(UPLOAD, ibSize, &indexBufferUpload);
     Engine::graphics->Allocate(GPU, ibSize, &indexBufferGPU);
 
     // copia ndices para o buffer da GPU usando o buffer de Upload
@@ -92,6 +155,15 @@ void Mesh::ConstantBuffer(uint objSize, uint objCount)
     // Constant Buffer  
     // ---------------
 
+    // uma nova alocao substitui a anterior (crescimento da capacidade);
+    // o contedo no  preservado e precisa ser copiado de novo
+    if (cbufferUpload)
+    {
+        cbufferUpload->Unmap(0, nullptr);
+        cbufferUpload->Release();
+        cbufferHeap->Release();
+    }
+
     // o tamanho dos constant buffers precisam ser mltiplos 
     // do tamanho de alocao mnima do hardware (256 bytes)
     cbufferElementSize = (objSize + 255) & ~255;
@@ -163,6 +235,42 @@ D3D12_VERTEX_BUFFER_VIEW* Mesh::VertexBufferView()
 
 // -------------------------------------------------------------------------------
 
+D3D12_VERTEX_BUFFER_VIEW* Mesh::PositionBufferView()
+{
+    positionBufferView.BufferLocation = positionBufferGPU->GetGPUVirtualAddress();
+    positionBufferView.StrideInBytes = positionBufferStride;
+    positionBufferView.SizeInBytes = positionBufferSize;
+
+    return &positionBufferView;
+}
+
+// -------------------------------------------------------------------------------
+
+D3D12_VERTEX_BUFFER_VIEW* Mesh::StreamViews()
+{
+    // sem buffer de posies separado existe apenas o buffer intercalado
+    if (!positionBufferGPU)
+        return VertexBufferView();
+
+    // vrtices s com posio
+    if (!vertexBufferGPU)
+        return PositionBufferView();
+
+    streamViews[0] = *PositionBufferView();
+    streamViews[1] = *VertexBufferView();
+
+    return streamViews;
+}
+
+// -------------------------------------------------------------------------------
+
+uint Mesh::StreamCount() const
+{
+    return (positionBufferGPU ? 1 : 0) + (vertexBufferGPU ? 1 : 0);
+}
+
+// -------------------------------------------------------------------------------
+
 D3D12_INDEX_BUFFER_VIEW * Mesh::IndexBufferView()
 {
     indexBufferView.BufferLocation = indexBufferGPU->GetGPUVirtualAddress();
@@ -16,6 +16,8 @@
 
 #include "Types.h"
 #include "Graphics.h"
+#include "Geometry.h"
+#include <array>
 #include <string>
 #include <unordered_map>
 using std::unordered_map;
@@ -23,15 +25,6 @@ using std::string;
 
 // -------------------------------------------------------------------------------
 
-struct SubMesh
-{
-    uint indexCount = 0;
-    uint startIndex = 0;
-    uint baseVertex = 0;
-};
-
-// -------------------------------------------------------------------------------
-
 class Mesh
 {
 private:
@@ -40,6 +33,13 @@ private:
     D3D12_VERTEX_BUFFER_VIEW vertexBufferView;                              // descritor do buffer de vrtices
     uint vertexBufferSize;                                                  // tamanho do buffer de vrtices
     uint vertexBufferStride;                                                // tamanho de um vrtice
+
+    ID3D12Resource* positionBufferUpload;                                   // buffer de Upload CPU -> GPU
+    ID3D12Resource* positionBufferGPU;                                      // buffer de posies na GPU
+    D3D12_VERTEX_BUFFER_VIEW positionBufferView;                            // descritor do buffer de posies
+    uint positionBufferSize;                                                // tamanho do buffer de posies
+    uint positionBufferStride;                                              // tamanho de uma posio
+    D3D12_VERTEX_BUFFER_VIEW streamViews[2];                                // posies (slot 0) e atributos (slot 1)
                                                                             
     ID3D12Resource* indexBufferUpload;                                      // buffer de Upload CPU -> GPU
     ID3D12Resource* indexBufferGPU;                                         // buffers na GPU
@@ -55,16 +55,27 @@ private:
                                                                             
 public:                                                                     
     unordered_map<string, SubMesh> SubMesh;                                 // uma malha pode armazenar mltiplas sub-malhas
+    Bounds bounds;                                                          // volumes envolventes no espao do objeto
+    XMFLOAT4X4 dequantize;                                                  // leva posies quantizadas ao espao do objeto
                                                                             
     Mesh();                                                                 // construtor
     ~Mesh();                                                                // destrutor
 
     void VertexBuffer(const void* vb, uint vbSize, uint vbStride);          // aloca e copia vrtices para vertex buffer 
+    void PositionBuffer(const void* pb, uint pbSize, uint pbStride);        // aloca e copia posies para buffer separado
+    void VertexBuffer(const void* vb, uint vbCount, uint vbStride,          // copia vrtices, opcionalmente separando
+        uint positionSize, bool splitPositions);                            // as posies em um buffer prprio (slot 0)
+
+    template<class VertexT>                                                 // converte vrtices para VertexT e copia
+    void VertexBuffer(const Geometry& geo, bool splitPositions = false);    // para vertex buffer
     void IndexBuffer(const void* ib, uint ibSize, DXGI_FORMAT ibFormat);    // aloca e copia ndices para index buffer 
     void ConstantBuffer(uint objSize, uint objCount = 1);                   // aloca constant buffer com tamanho solicitado
     void CopyConstants(const void* cbData, uint cbIndex = 0);               // copia dados para o constant buffer
 
     D3D12_VERTEX_BUFFER_VIEW * VertexBufferView();                          // retorna descritor (view) do Vertex Buffer
+    D3D12_VERTEX_BUFFER_VIEW * PositionBufferView();                        // retorna descritor (view) do buffer de posies
+    D3D12_VERTEX_BUFFER_VIEW * StreamViews();                               // retorna descritores de todos os fluxos de vrtices
+    uint StreamCount() const;                                               // retorna nmero de fluxos de vrtices
     D3D12_INDEX_BUFFER_VIEW * IndexBufferView();                            // retorna descritor (view) do Index Buffer
     ID3D12DescriptorHeap* ConstantBufferHeap();                             // retorna heap de descritores
     D3D12_GPU_DESCRIPTOR_HANDLE ConstantBufferHandle(uint cbIndex = 0);     // retorna handle de um descritor
@@ -72,5 +83,43 @@ public:
 
 // -------------------------------------------------------------------------------
 
+template<class VertexT>
+void Mesh::VertexBuffer(const Geometry& geo, bool splitPositions)
+{
+    // converte os vrtices e guarda a matriz que desfaz a quantizao
+    vector<VertexT> data;
+    geo.PackVertices(data, dequantize);
+
+    VertexBuffer(data.data(), uint(data.size()), VertexDescriptor<VertexT>::stride, 
+        VertexDescriptor<VertexT>::positionSize, splitPositions);
+}
+
+// -------------------------------------------------------------------------------
+
+// input layout gerado a partir do tipo de vrtice; com posies separadas os
+// demais atributos vm do slot 1, contados a partir do fim da posio
+template<class VertexT>
+std::array<D3D12_INPUT_ELEMENT_DESC, VertexDescriptor<VertexT>::count> InputLayout(bool splitPositions)
+{
+    using Descriptor = VertexDescriptor<VertexT>;
+
+    std::array<D3D12_INPUT_ELEMENT_DESC, Descriptor::count> layout = {};
+    std::array<VertexAttribute, Descriptor::count> attributes = Descriptor::Attributes();
+
+    for (uint i = 0; i < Descriptor::count; ++i)
+    {
+        bool position = (attributes[i].offset == 0);
+        uint slot = (splitPositions && !position) ? 1 : 0;
+        uint base = (splitPositions && !position) ? Descriptor::positionSize : 0;
+
+        layout[i] = { attributes[i].semantic, 0, attributes[i].format, slot, 
+            attributes[i].offset - base, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 };
+    }
+
+    return layout;
+}
+
+// -------------------------------------------------------------------------------
+
 #endif
 
@@ -0,0 +1,358 @@
+/**********************************************************************************
+// Meshlet (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Divide malhas trianguladas em meshlets: grupos pequenos de
+//              tringulos vizinhos com poucos vrtices, cada um com uma esfera
+//              envolvente e um cone de normais. Os limites permitem descartar
+//              grupos inteiros fora do frustum ou voltados para trs na CPU,
+//              e os dados seguem o formato esperado por mesh shaders
+//
+**********************************************************************************/
+
+#include "Meshlet.h"
+#include <climits>
+#include <cfloat>
+#include <cmath>
+
+// -------------------------------------------------------------------------------
+// Funes auxiliares
+
+// posio do vrtice v em um vetor intercalado
+static const float* PositionAt(const float* positions, uint vertexStride, uint v)
+{
+    return reinterpret_cast<const float*>(reinterpret_cast<const byte*>(positions) + size_t(v) * vertexStride);
+}
+
+// -------------------------------------------------------------------------------
+
+uint BuildMeshlets(vector<Meshlet>& meshlets, vector<uint>& meshletVertices, vector<byte>& meshletTriangles,
+    const uint* indices, uint indexCount, const float* positions, uint vertexCount, uint vertexStride,
+    uint maxVertices, uint maxTriangles)
+{
+    meshlets.clear();
+    meshletVertices.clear();
+    meshletTriangles.clear();
+
+    uint triCount = indexCount / 3;
+    if (triCount == 0)
+        return 0;
+
+    // ndices locais cabem em um byte
+    maxVertices = (maxVertices < 3 ? 3 : (maxVertices > 256 ? 256 : maxVertices));
+    maxTriangles = (maxTriangles < 1 ? 1 : maxTriangles);
+
+    // tringulos ao redor de cada vrtice (formato compacto)
+    vector<uint> offsets(size_t(vertexCount) + 1, 0);
+    vector<uint> adjacency(size_t(triCount) * 3);
+
+    for (uint i = 0; i < triCount * 3; ++i)
+        ++offsets[size_t(indices[i]) + 1];
+    for (uint v = 0; v < vertexCount; ++v)
+        offsets[size_t(v) + 1] += offsets[v];
+
+    vector<uint> cursor(offsets.begin(), offsets.end() - 1);
+    for (uint i = 0; i < triCount * 3; ++i)
+        adjacency[cursor[indices[i]]++] = i / 3;
+
+    // tringulos ainda no emitidos em cada vrtice
+    vector<uint> live(vertexCount);
+    for (uint v = 0; v < vertexCount; ++v)
+        live[v] = offsets[size_t(v) + 1] - offsets[v];
+
+    vector<byte> emitted(triCount, 0);
+    vector<uint> local(vertexCount, UINT_MAX);  // ndice do vrtice no meshlet atual
+
+    meshletVertices.reserve(size_t(triCount) * 3 / 2);
+    meshletTriangles.reserve(size_t(triCount) * 3);
+
+    Meshlet current;
+    float center[3] = { 0.0f, 0.0f, 0.0f };     // soma dos centroides do meshlet atual
+    uint next = 0;                              // prximo tringulo na ordem original
+
+    // fecha o meshlet atual e comea outro vazio
+    auto finish = [&]()
+    {
+        for (uint k = 0; k < current.vertexCount; ++k)
+            local[meshletVertices[size_t(current.vertexOffset) + k]] = UINT_MAX;
+
+        meshlets.push_back(current);
+
+        current.vertexOffset = uint(meshletVertices.size());
+        current.triangleOffset = uint(meshletTriangles.size());
+        current.vertexCount = 0;
+        current.triangleCount = 0;
+        center[0] = center[1] = center[2] = 0.0f;
+    };
+
+    for (uint emittedCount = 0; emittedCount < triCount; ++emittedCount)
+    {
+        // candidato: tringulo vizinho que acrescenta menos vrtices novos,
+        // desempatado pela distncia ao centro do meshlet
+        uint best = UINT_MAX;
+        uint bestNew = UINT_MAX;
+        float bestDistance = FLT_MAX;
+
+        if (current.triangleCount > 0)
+        {
+            float c[3] = {
+                center[0] / current.triangleCount,
+                center[1] / current.triangleCount,
+                center[2] / current.triangleCount };
+
+            for (uint k = 0; k < current.vertexCount; ++k)
+            {
+                uint v = meshletVertices[size_t(current.vertexOffset) + k];
+                if (live[v] == 0)
+                    continue;
+
+                for (uint a = offsets[v]; a < offsets[size_t(v) + 1]; ++a)
+                {
+                    uint t = adjacency[a];
+                    if (emitted[t])
+                        continue;
+
+                    const uint* tri = &indices[size_t(t) * 3];
+                    uint newVertices = (local[tri[0]] == UINT_MAX) + (local[tri[1]] == UINT_MAX) + (local[tri[2]] == UINT_MAX);
+                    if (newVertices > bestNew)
+                        continue;
+
+                    float distance = 0.0f;
+                    for (uint axis = 0; axis < 3; ++axis)
+                    {
+                        float m = (PositionAt(positions, vertexStride, tri[0])[axis]
+                                 + PositionAt(positions, vertexStride, tri[1])[axis]
+                                 + PositionAt(positions, vertexStride, tri[2])[axis]) / 3.0f - c[axis];
+                        distance += m * m;
+                    }
+
+                    if (newVertices < bestNew || distance < bestDistance)
+                    {
+                        best = t;
+                        bestNew = newVertices;
+                        bestDistance = distance;
+                    }
+                }
+            }
+        }
+
+        // sem vizinhos: continua com o prximo tringulo da ordem original
+        if (best == UINT_MAX)
+        {
+            while (emitted[next])
+                ++next;
+            best = next;
+
+            const uint* tri = &indices[size_t(best) * 3];
+            bestNew = (local[tri[0]] == UINT_MAX) + (local[tri[1]] == UINT_MAX) + (local[tri[2]] == UINT_MAX);
+        }
+
+        // o tringulo no cabe: ele comea o prximo meshlet
+        if (current.vertexCount + bestNew > maxVertices || current.triangleCount + 1 > maxTriangles)
+            finish();
+
+        const uint* tri = &indices[size_t(best) * 3];
+        for (uint c = 0; c < 3; ++c)
+        {
+            uint v = tri[c];
+            if (local[v] == UINT_MAX)
+            {
+                local[v] = current.vertexCount++;
+                meshletVertices.push_back(v);
+            }
+
+            meshletTriangles.push_back(byte(local[v]));
+            --live[v];
+
+            const float* p = PositionAt(positions, vertexStride, v);
+            center[0] += p[0] / 3.0f;
+            center[1] += p[1] / 3.0f;
+            center[2] += p[2] / 3.0f;
+        }
+
+        emitted[best] = 1;
+        ++current.triangleCount;
+    }
+
+    if (current.triangleCount > 0)
+        finish();
+
+    return uint(meshlets.size());
+}
+
+// -------------------------------------------------------------------------------
+
+MeshletBounds ComputeMeshletBounds(const Meshlet& meshlet, const uint* meshletVertices,
+    const byte* meshletTriangles, const float* positions, uint vertexStride)
+{
+    MeshletBounds bounds = {};
+    bounds.coneCutoff = 1.0f;
+
+    if (meshlet.vertexCount == 0)
+        return bounds;
+
+    const uint* vertices = meshletVertices + meshlet.vertexOffset;
+    const byte* triangles = meshletTriangles + meshlet.triangleOffset;
+
+    auto position = [&](uint k) { return XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(PositionAt(positions, vertexStride, vertices[k]))); };
+
+    // esfera de Ritter: dimetro inicial entre pontos distantes, depois cresce
+    // at conter todos os vrtices
+    XMVECTOR p0 = position(0);
+    XMVECTOR p1 = p0;
+    float farthest = 0.0f;
+    for (uint k = 0; k < meshlet.vertexCount; ++k)
+    {
+        float d = XMVectorGetX(XMVector3LengthSq(position(k) - p0));
+        if (d > farthest) { farthest = d; p1 = position(k); }
+    }
+
+    XMVECTOR p2 = p1;
+    farthest = 0.0f;
+    for (uint k = 0; k < meshlet.vertexCount; ++k)
+    {
+        float d = XMVectorGetX(XMVector3LengthSq(position(k) - p1));
+        if (d > farthest) { farthest = d; p2 = position(k); }
+    }
+
+    XMVECTOR center = (p1 + p2) * 0.5f;
+    float radius = 0.5f * sqrtf(farthest);
+
+    for (uint k = 0; k < meshlet.vertexCount; ++k)
+    {
+        float d = XMVectorGetX(XMVector3Length(position(k) - center));
+        if (d > radius)
+        {
+            float grown = 0.5f * (radius + d);
+            center += (position(k) - center) * ((grown - radius) / d);
+            radius = grown;
+        }
+    }
+
+    XMStoreFloat3(&bounds.center, center);
+    bounds.radius = radius;
+    bounds.coneApex = bounds.center;
+
+    // cone de normais: eixo na mdia das normais dos tringulos e
+    // abertura dada pela normal mais afastada do eixo
+    XMVECTOR axis = XMVectorZero();
+    for (uint t = 0; t < meshlet.triangleCount; ++t)
+    {
+        XMVECTOR a = position(triangles[t * 3 + 0]);
+        XMVECTOR b = position(triangles[t * 3 + 1]);
+        XMVECTOR c = position(triangles[t * 3 + 2]);
+        XMVECTOR n = XMVector3Cross(b - a, c - a);
+        if (XMVectorGetX(XMVector3LengthSq(n)) > 0.0f)
+            axis += XMVector3Normalize(n);
+    }
+
+    if (XMVectorGetX(XMVector3LengthSq(axis)) == 0.0f)
+        return bounds;
+
+    axis = XMVector3Normalize(axis);
+    XMStoreFloat3(&bounds.coneAxis, axis);
+
+    float minDot = 1.0f;
+    for (uint t = 0; t < meshlet.triangleCount; ++t)
+    {
+        XMVECTOR a = position(triangles[t * 3 + 0]);
+        XMVECTOR b = position(triangles[t * 3 + 1]);
+        XMVECTOR c = position(triangles[t * 3 + 2]);
+        XMVECTOR n = XMVector3Cross(b - a, c - a);
+        if (XMVectorGetX(XMVector3LengthSq(n)) > 0.0f)
+        {
+            float d = XMVectorGetX(XMVector3Dot(XMVector3Normalize(n), axis));
+            minDot = (d < minDot ? d : minDot);
+        }
+    }
+
+    // normais espalhadas demais: o meshlet nunca  descartado pelo cone
+    if (minDot <= 0.1f)
+        return bounds;
+
+    // pice do cone: ponto do eixo atrs de todos os planos dos tringulos
+    float maxT = 0.0f;
+    for (uint t = 0; t < meshlet.triangleCount; ++t)
+    {
+        XMVECTOR a = position(triangles[t * 3 + 0]);
+        XMVECTOR b = position(triangles[t * 3 + 1]);
+        XMVECTOR c = position(triangles[t * 3 + 2]);
+        XMVECTOR n = XMVector3Cross(b - a, c - a);
+        if (XMVectorGetX(XMVector3LengthSq(n)) == 0.0f)
+            continue;
+
+        n = XMVector3Normalize(n);
+        float dc = XMVectorGetX(XMVector3Dot(center - a, n));
+        float dn = XMVectorGetX(XMVector3Dot(axis, n));
+        float t0 = dc / dn;
+        maxT = (t0 > maxT ? t0 : maxT);
+    }
+
+    XMStoreFloat3(&bounds.coneApex, center - axis * maxT);
+    bounds.coneCutoff = sqrtf(1.0f - minDot * minDot);
+
+    return bounds;
+}
+
+// -------------------------------------------------------------------------------
+
+MeshletFrustum ComputeMeshletFrustum(FXMMATRIX worldViewProj)
+{
+    MeshletFrustum frustum;
+
+    // linhas da transposta so as colunas da matriz (conveno de vetor-linha);
+    // um ponto est dentro se 0 <= z <= w e -w <= x,y <= w
+    XMMATRIX m = XMMatrixTranspose(worldViewProj);
+
+    XMStoreFloat4(&frustum.planes[0], XMPlaneNormalize(m.r[3] + m.r[0]));   // esquerda
+    XMStoreFloat4(&frustum.planes[1], XMPlaneNormalize(m.r[3] - m.r[0]));   // direita
+    XMStoreFloat4(&frustum.planes[2], XMPlaneNormalize(m.r[3] + m.r[1]));   // inferior
+    XMStoreFloat4(&frustum.planes[3], XMPlaneNormalize(m.r[3] - m.r[1]));   // superior
+    XMStoreFloat4(&frustum.planes[4], XMPlaneNormalize(m.r[2]));            // prximo
+    XMStoreFloat4(&frustum.planes[5], XMPlaneNormalize(m.r[3] - m.r[2]));   // distante
+
+    // o observador  o ponto levado a (0,0,z,0) pela projeo: em perspectiva
+    //  a posio da cmera; em projeo ortogrfica  a direo da vista
+    XMMATRIX inverse = XMMatrixInverse(nullptr, worldViewProj);
+    XMVECTOR eye = XMVector4Transform(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), inverse);
+    float w = XMVectorGetW(eye);
+
+    if (fabsf(w) > 1e-6f)
+        eye = XMVectorSetW(eye / w, 1.0f);
+    else
+        eye = XMVectorSetW(-XMVector3Normalize(eye), 0.0f);
+
+    XMStoreFloat4(&frustum.eye, eye);
+    return frustum;
+}
+
+// -------------------------------------------------------------------------------
+
+bool MeshletVisible(const MeshletBounds& bounds, const MeshletFrustum& frustum)
+{
+    XMVECTOR center = XMLoadFloat3(&bounds.center);
+
+    // esfera inteiramente atrs de um dos planos
+    for (uint i = 0; i < 6; ++i)
+        if (XMVectorGetX(XMPlaneDotCoord(XMLoadFloat4(&frustum.planes[i]), center)) < -bounds.radius)
+            return false;
+
+    if (bounds.coneCutoff >= 1.0f)
+        return true;
+
+    // direo da vista at o pice dentro do cone: todos os tringulos de costas
+    XMVECTOR eye = XMLoadFloat4(&frustum.eye);
+    XMVECTOR view = XMVectorSetW(XMLoadFloat3(&bounds.coneApex) * frustum.eye.w - eye, 0.0f);
+
+    if (XMVectorGetX(XMVector3LengthSq(view)) == 0.0f)
+        return true;
+
+    view = XMVector3Normalize(view);
+
+    return XMVectorGetX(XMVector3Dot(view, XMLoadFloat3(&bounds.coneAxis))) < bounds.coneCutoff;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,99 @@
+/**********************************************************************************
+// Meshlet (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Divide malhas trianguladas em meshlets: grupos pequenos de
+//              tringulos vizinhos com poucos vrtices, cada um com uma esfera
+//              envolvente e um cone de normais. Os limites permitem descartar
+//              grupos inteiros fora do frustum ou voltados para trs na CPU,
+//              e os dados seguem o formato esperado por mesh shaders
+//
+**********************************************************************************/
+
+#ifndef DXUT_MESHLET_H_
+#define DXUT_MESHLET_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <vector>
+#include <DirectXMath.h>
+using namespace DirectX;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+const uint MeshletMaxVertices = 64;         // vrtices por meshlet
+const uint MeshletMaxTriangles = 124;       // tringulos por meshlet
+
+// -------------------------------------------------------------------------------
+
+struct Meshlet
+{
+    uint vertexOffset = 0;                  // primeiro vrtice em meshletVertices
+    uint triangleOffset = 0;                // primeiro ndice local em meshletTriangles
+    uint vertexCount = 0;                   // nmero de vrtices
+    uint triangleCount = 0;                 // nmero de tringulos
+};
+
+// -------------------------------------------------------------------------------
+
+struct MeshletBounds
+{
+    XMFLOAT3 center;                        // centro da esfera envolvente
+    float radius;                           // raio da esfera envolvente
+    XMFLOAT3 coneApex;                      // pice do cone de normais
+    XMFLOAT3 coneAxis;                      // eixo do cone de normais
+    float coneCutoff;                       // seno da abertura do cone (1 = sem descarte)
+};
+
+// -------------------------------------------------------------------------------
+
+// vista usada no descarte, no espao do objeto
+struct MeshletFrustum
+{
+    XMFLOAT4 planes[6];                     // planos normalizados voltados para dentro
+    XMFLOAT4 eye;                           // observador (w = 1) ou direo oposta  vista (w = 0)
+};
+
+// -------------------------------------------------------------------------------
+
+// agrupa os tringulos em meshlets com no mximo maxVertices vrtices e maxTriangles
+// tringulos, crescendo cada grupo pelos vizinhos que acrescentam menos vrtices
+// novos; os ndices locais de cada tringulo ficam em meshletTriangles (3 por
+// tringulo) e apontam para meshletVertices; retorna o nmero de meshlets
+uint BuildMeshlets(
+    vector<Meshlet>& meshlets,              // meshlets gerados
+    vector<uint>& meshletVertices,          // vrtices de cada meshlet
+    vector<byte>& meshletTriangles,         // tringulos de cada meshlet (ndices locais)
+    const uint* indices,                    // ndices da malha (lista de tringulos)
+    uint indexCount,                        // nmero de ndices
+    const float* positions,                 // posio (x,y,z) do primeiro vrtice
+    uint vertexCount,                       // nmero de vrtices
+    uint vertexStride,                      // distncia em bytes entre posies
+    uint maxVertices = MeshletMaxVertices,  // limite de vrtices por meshlet
+    uint maxTriangles = MeshletMaxTriangles); // limite de tringulos por meshlet
+
+// esfera envolvente e cone de normais dos tringulos de um meshlet
+MeshletBounds ComputeMeshletBounds(
+    const Meshlet& meshlet,                 // meshlet
+    const uint* meshletVertices,            // vrtices dos meshlets
+    const byte* meshletTriangles,           // tringulos dos meshlets
+    const float* positions,                 // posio (x,y,z) do primeiro vrtice
+    uint vertexStride);                     // distncia em bytes entre posies
+
+// planos do frustum e observador no espao do objeto, extrados da matriz
+// combinada (world x view x proj) em perspectiva ou projeo ortogrfica
+MeshletFrustum ComputeMeshletFrustum(FXMMATRIX worldViewProj);
+
+// verdadeiro se o meshlet pode ter tringulos visveis: a esfera toca o frustum
+// e o observador est fora do cone de faces traseiras (o cone s  exato quando
+// a matriz de mundo tem escala uniforme)
+bool MeshletVisible(const MeshletBounds& bounds, const MeshletFrustum& frustum);
+
+// -------------------------------------------------------------------------------
+
+#endif
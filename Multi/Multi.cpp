@@ -11,25 +11,30 @@
 
 #include "DXUT.h"
 #include "string"
+#include <cfloat>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <random>
 #include <sstream>
 
 
 // ------------------------------------------------------------------------------
 
-struct ObjData {
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
+// malha carregada de arquivo .obj (usa o mesmo armazenamento da Geometry,
+// de forma que normais e demais processamentos valem para ambos)
+struct ObjData : public Geometry {};
 
-    size_t VertexCount() const { return vertices.size(); }
-    size_t IndexCount() const { return indices.size(); }
-    Vertex* VertexData() { return vertices.data(); }
-    uint32_t* IndexData() { return indices.data(); }
-};
+// tipo dos vrtices enviados  GPU: define o vertex buffer e o input layout
+using SceneVertex = QuantizedVertex;
+
+// o input layout gerado precisa conter tudo o que Vertex.hlsl l
+static_assert(ShaderAccepts<SceneVertex>::value, "SceneVertex no fornece um atributo lido pelo vertex shader");
 
+// constantes de cada objeto, iguais em todas as vistas (register b0)
 struct ObjectConstants
 {
-    XMFLOAT4X4 WorldViewProj =
+    XMFLOAT4X4 World =
     { 1.0f, 0.0f, 0.0f, 0.0f,
       0.0f, 1.0f, 0.0f, 0.0f,
       0.0f, 0.0f, 1.0f, 0.0f,
@@ -38,6 +43,82 @@ struct ObjectConstants
     XMFLOAT4 objColor;
 };
 
+// constantes de cada vista, enviadas como constantes raiz (register b1)
+struct ViewConstants
+{
+    XMFLOAT4X4 ViewProj =
+    { 1.0f, 0.0f, 0.0f, 0.0f,
+      0.0f, 1.0f, 0.0f, 0.0f,
+      0.0f, 0.0f, 1.0f, 0.0f,
+      0.0f, 0.0f, 0.0f, 1.0f };
+};
+
+// descrio de um modelo de objeto: primitiva gerada em Init ou arquivo .obj
+// carregado na primeira instncia, com a transformao inicial das instncias
+struct PrefabDesc
+{
+    const char* name;                       // nome usado nas buscas e mensagens
+    char key;                               // tecla que cria uma instncia
+    Geometry (*build)();                    // gera a primitiva (nullptr para arquivos)
+    bool normals;                           // primitiva precisa calcular normais
+    const char* file;                       // arquivo .obj (nullptr para primitivas)
+    float scale;                            // escala inicial
+    float height;                           // altura inicial
+};
+
+static const PrefabDesc PrefabTable[] =
+{
+    { "quad",      'Q', [] { return Geometry(Quad(2.0f, 2.0f)); },                 true,  nullptr,       0.5f, 0.5f },
+    { "box",       'B', [] { return Geometry(Box(2.0f, 2.0f, 2.0f)); },            true,  nullptr,       0.5f, 0.5f },
+    { "cylinder",  'C', [] { return Geometry(CylinderLadder(1.0f, 1.0f, 3.0f)); }, false, nullptr,       0.5f, 0.75f },
+    { "sphere",    'S', [] { return Geometry(SphereLadder(1.0f)); },               false, nullptr,       0.5f, 0.5f },
+    { "geoSphere", 'G', [] { return Geometry(GeoSphere(1.0f, 3)); },               true,  nullptr,       0.5f, 0.5f },
+    { "grid",      'P', [] { return Geometry(Grid(3.0f, 3.0f, 20, 20)); },         true,  nullptr,       1.0f, 0.0f },
+    { "ball",      '1', nullptr,                                                   false, "ball.obj",    1.0f, 0.0f },
+    { "capsule",   '2', nullptr,                                                   false, "capsule.obj", 1.0f, 0.0f },
+    { "house",     '3', nullptr,                                                   false, "house.obj",   1.0f, 0.0f },
+    { "monkey",    '4', nullptr,                                                   false, "monkey.obj",  1.0f, 0.0f },
+    { "thorus",    '5', nullptr,                                                   false, "thorus.obj",  1.0f, 0.0f },
+    { "plane",     '6', nullptr,                                                   false, "plane.obj",   1.0f, 0.0f },
+};
+
+// lote de primitivas estticas montado na primeira vez que  pedido (tecla 7)
+static const PrefabDesc PropsDesc = { "props", 0, nullptr, false, nullptr, 1.0f, 0.0f };
+
+// modelo residente: a geometria  processada e enviada  GPU uma nica vez;
+// cada instncia ocupa apenas uma entrada do buffer constante da malha
+struct Prefab
+{
+    const PrefabDesc* desc = nullptr;       // descrio na tabela
+    Geometry geo;                           // geometria processada (sub-malhas, nveis, meshlets)
+    Mesh* mesh = nullptr;                   // buffers na GPU (nullptr at ser carregado)
+    vector<uint> freeSlots;                 // entradas livres do buffer constante
+    uint capacity = 0;                      // entradas alocadas no buffer constante
+};
+
+// instncia pedida a SpawnBatch
+struct SpawnRequest
+{
+    uint prefab;                            // modelo na PrefabTable
+    Transform local;                        // transformao inicial
+};
+
+// movimento de um objeto do modo de estresse
+struct StressMotion
+{
+    Handle object;                          // objeto animado
+    XMFLOAT3 center;                        // posio de referncia
+    float radius;                           // amplitude do movimento
+    float speed;                            // velocidade angular (rad/s)
+    float phase;                            // ngulo inicial
+    float scale;                            // escala uniforme
+    uint pattern;                           // rbita, oscilao, giro ou parado
+};
+
+const uint ScatterCount = 10000;            // objetos criados pela tecla N
+
+enum StressPatterns { STRESS_ORBIT, STRESS_BOB, STRESS_SPIN, STRESS_STATIC, STRESS_PATTERNS };
+
 // ------------------------------------------------------------------------------
 
 class Multi : public App
@@ -45,19 +126,42 @@ class Multi : public App
 private:
     ID3D12RootSignature* rootSignature = nullptr;
     ID3D12PipelineState* pipelineState = nullptr;
-    vector<Object> scene;
-    Object* selectedObj;
-    int selectedIndex = -1;
+    SlotMap<Object> scene;                  // objetos contguos com handles estveis
+    Handle selected;                        // objeto selecionado (invlido se no h seleo)
 
-    Geometry quad;
-    Geometry box;
-    Geometry cylinder;
-    Geometry sphere;
-    Geometry geoSphere;
-    Geometry grid;
+    vector<Prefab> prefabs;                 // modelos da PrefabTable, na mesma ordem
 
     vector<Object> linhas;
 
+    Terrain* terrain = nullptr;             // terreno criado na primeira vez que  exibido
+    Object terrainObj;                      // buffers e peas visveis do terreno em cada vista
+    bool showTerrain = false;
+    uint terrainBudget = 65536;             // tringulos de terreno por vista
+
+    TransformStore transforms;              // matrizes de mundo da cena em estrutura de arrays
+    CullingStore culling;                   // caixas de mundo da cena em estrutura de arrays
+    vector<uint> visibleObjects[4];         // objetos que passaram pelo descarte em cada vista
+    uint culledObjects[4] = {};             // objetos descartados em cada vista no ltimo quadro
+    bool viewActive[4] = {};                // vista desenhada no ltimo quadro
+    ViewConstants viewConstants[4];         // view-projection de cada vista (transpostas)
+    float viewHeights[4] = {};              // altura da viewport de cada vista no ltimo quadro
+    bool viewDirty[4] = {};                 // cmera ou viewport da vista mudou neste quadro
+    Handle painted;                         // objeto pintado como selecionado no buffer constante
+    Handle previous;                        // objeto selecionado antes do atual
+    SceneGraph graph;                       // hierarquia de transformaes dos objetos
+    vector<Handle> nodeObjects;             // objeto de cada n da hierarquia (por identificador)
+    uint updatedObjects = 0;                // objetos com buffer constante atualizado no quadro
+
+    bool stress = false;                    // modo de estresse ativo
+    uint stressCount = 100000;              // objetos criados pelo modo de estresse
+    float stressChurn = 200.0f;             // objetos removidos e recriados por segundo
+    float stressDebt = 0.0f;                // frao de troca acumulada entre quadros
+    float stressTime = 0.0f;                // tempo da animao em segundos
+    vector<uint> stressPrefabs;             // modelos sorteados pelo modo de estresse
+    vector<StressMotion> stressMotions;     // movimento de cada objeto do modo de estresse
+    std::mt19937 stressRandom;              // gerador com semente fixa (execues comparveis)
+    Profiler profiler;                      // tempo de CPU de cada fase do quadro
+
     Timer timer;
     bool spinning = true;
     bool changeTranslation = true;
@@ -95,12 +199,31 @@ private:
     D3D12_VIEWPORT viewPortOrtSide;
     D3D12_VIEWPORT viewPortOrtTop;
     bool quadView = false;
+    bool splitPositions = true;
 
 public:
     ObjData LoadOBJ(const std::string& filename);
+    void OptimizeGeometry(Geometry& geo, const std::string& name);
     void Init();
+    Handle AddObject(Object obj);
+    Handle AddObject(Object obj, const Transform& local);
+    bool RemoveObject(Handle handle);
+    uint FindPrefab(const char* name) const;
+    void LoadPrefab(uint index);
+    void GrowPrefab(uint index, uint capacity);
+    Handle Instantiate(uint index);
+    Handle Instantiate(uint index, const Transform& local);
+    vector<Handle> SpawnBatch(const vector<SpawnRequest>& requests);
+    void StartStress();
+    void StopStress();
+    void SpawnStress(uint count);
+    void RemoveStress(uint index);
+    void AnimateStress(float dt);
     void Update();
+    void BindView(const ViewConstants& constants);
     void DrawObjects(int);
+    void DrawSubMeshes(const Object& obj, int view);
+    void DrawTerrain(int view);
     void DrawLines();
     void Draw();
     void Finalize();
@@ -115,8 +238,15 @@ ObjData Multi::LoadOBJ(const std::string& filename) {
     std::ifstream file(filename);
     std::string line;
 
-    std::vector<XMFLOAT3> positions;
-    std::vector<XMFLOAT3> normals;
+    // listas intermedirias ficam na arena de rascunho e os ndices de
+    // cada face reaproveitam a mesma memria de uma face para a outra
+    ArenaScope scope(ScratchArena());
+    std::pmr::memory_resource* scratch = &ScratchArena();
+
+    std::pmr::vector<XMFLOAT3> positions(scratch);
+    std::pmr::vector<XMFLOAT3> normals(scratch);
+    std::pmr::vector<uint32_t> vertexIndices(scratch);
+    std::pmr::vector<uint32_t> normalIndices(scratch);
 
     while (std::getline(file, line)) {
         std::istringstream iss(line);
@@ -137,8 +267,8 @@ ObjData Multi::LoadOBJ(const std::string& filename) {
         }
         else if (prefix == "f") {
             // Faces (ndices de vrtices, coordenadas de textura e normais)
-            std::vector<uint32_t> vertexIndices;
-            std::vector<uint32_t> normalIndices;
+            vertexIndices.clear();
+            normalIndices.clear();
 
             std::string faceStr;
             std::getline(iss, faceStr);
@@ -153,12 +283,12 @@ ObjData Multi::LoadOBJ(const std::string& filename) {
                     }
                 }
 
-                std::istringstream vertexStream(vertexData);
+                char* next;
                 uint32_t vIdx, nIdx;
 
-                vertexStream >> vIdx;  // ndice de vrtice
-                if (vertexStream.peek() == ' ') vertexStream.ignore(); // Pula se houver coordenadas de textura
-                vertexStream >> nIdx;  // ndice de normal
+                vIdx = uint32_t(strtoul(vertexData.c_str(), &next, 10));  // ndice de vrtice
+                if (*next == ' ') ++next;                                   // Pula se houver coordenadas de textura
+                nIdx = uint32_t(strtoul(next, &next, 10));                  // ndice de normal
 
                 // Convertendo de 1-based para 0-based
                 vertexIndices.push_back(vIdx - 1);
@@ -175,6 +305,7 @@ ObjData Multi::LoadOBJ(const std::string& filename) {
     }
 
     // Adiciona os vrtices ao ObjData
+    objData.vertices.reserve(positions.size());
     for (auto& pos : positions) {
         Vertex vertex;
         vertex.pos = pos;
@@ -182,9 +313,80 @@ ObjData Multi::LoadOBJ(const std::string& filename) {
         objData.vertices.push_back(vertex);
     }
 
+    // normais com vincos preservam as arestas vivas dos modelos
+    objData.GenerateNormals(CREASE_SPLIT);
+    OptimizeGeometry(objData, filename);
+
     return objData;
 }
 
+// ------------------------------------------------------------------------------
+
+void Multi::OptimizeGeometry(Geometry& geo, const std::string& name)
+{
+    // passagens na CPU leem apenas as posies, em um vetor compacto
+    geo.BuildPositionStream();
+
+    float acmrBefore = geo.ACMR();
+    float overdrawBefore = geo.Overdraw();
+    uint verticesBefore = geo.VertexCount();
+
+    // nveis de detalhe simplificados, desenhados conforme o tamanho na tela
+    // (escadas de tessellation j trazem os seus nveis)
+    if (geo.lods.empty())
+        geo.GenerateLods();
+
+    // reordena tringulos para reaproveitar vrtices transformados na GPU,
+    // ordena blocos de tringulos para reduzir o overdraw, agrupa os tringulos
+    // em meshlets descartveis na CPU e, por fim, renumera os vrtices na 
+    // ordem em que os tringulos os acessam
+    geo.OptimizeVertexCache();
+    geo.OptimizeOverdraw();
+    geo.BuildMeshlets();
+    geo.OptimizeVertexFetch();
+
+    std::ostringstream text;
+    text.precision(3);
+    text << std::fixed << name 
+         << ": ACMR " << acmrBefore << " -> " << geo.ACMR()
+         << ", overdraw " << overdrawBefore << " -> " << geo.Overdraw()
+         << ", vertices " << verticesBefore << " -> " << geo.VertexCount() << "\n";
+
+    for (const LodLevel& level : geo.lods)
+        text << "    LOD: " << level.indexCount / 3 << " triangulos, erro " << level.error << "\n";
+
+    text << "    meshlets: " << geo.meshlets.size() << "\n";
+
+    OutputDebugString(text.str().c_str());
+
+    // ndices de 16 bits sempre que os vrtices permitirem
+    geo.PackIndices();
+
+    // volumes envolventes calculados uma nica vez, no espao do objeto
+    geo.ComputeBounds();
+}
+
+// ------------------------------------------------------------------------------
+
+// pixels ocupados na tela por uma unidade do espao do objeto: escala vertical
+// da projeo dividida pela profundidade (w) da origem do objeto na vista
+static float PixelsPerUnit(FXMMATRIX world, CXMMATRIX view, CXMMATRIX proj, float viewportHeight)
+{
+    XMVECTOR origin = XMVector4Transform(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), world * view * proj);
+    float w = XMVectorGetW(origin);
+
+    // objeto sobre a cmera ou atrs dela: usa o nvel mais detalhado
+    if (w <= 0.0001f)
+        return FLT_MAX;
+
+    // maior escala aplicada pela matriz de mundo
+    float scale = XMVectorGetX(XMVectorMax(XMVector3Length(world.r[0]),
+        XMVectorMax(XMVector3Length(world.r[1]), XMVector3Length(world.r[2]))));
+
+    return scale * XMVectorGetY(proj.r[1]) * 0.5f * viewportHeight / w;
+}
+
+// ------------------------------------------------------------------------------
 
 void Multi::Init()
 {
@@ -323,65 +525,53 @@ void Multi::Init()
     // Criao da Geometria: Vrtices e ndices
     // ----------------------------------------
 
-    quad =Quad(2.0f, 2.0f);
-    box = Box(2.0f, 2.0f, 2.0f);
-    cylinder = Cylinder(1.0f, 1.0f, 3.0f, 20, 20);
-    sphere = Sphere(1.0f, 20, 20);
-    geoSphere = GeoSphere(1.0f, 3);
-    grid = Grid(3.0f, 3.0f, 20, 20);
+    // primitivas geradas e otimizadas aqui; arquivos .obj ficam para
+    // a primeira instncia do modelo
+    prefabs.resize(std::size(PrefabTable));
+
+    for (uint i = 0; i < prefabs.size(); ++i)
+    {
+        const PrefabDesc& desc = PrefabTable[i];
+        prefabs[i].desc = &desc;
+
+        if (!desc.build)
+            continue;
+
+        Geometry& geo = prefabs[i].geo;
+        geo = desc.build();
+
+        for (auto& v : geo.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
 
-    for (auto& v : quad.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
-    for (auto& v : box.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
-    for (auto& v : cylinder.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
-    for (auto& v : sphere.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
-    for (auto& v : geoSphere.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
-    for (auto& v : grid.vertices) v.color = XMFLOAT4(DirectX::Colors::DimGray);
+        if (desc.normals)
+            geo.GenerateNormals();
+
+        OptimizeGeometry(geo, desc.name);
+    }
 
     // ---------------------------------------------------------------
     // Alocao e Cpia de Vertex, Index e Constant Buffers para a GPU
     // ---------------------------------------------------------------
 
+    // todas as cpias da inicializao saem de um nico buffer de upload
+    graphics->BeginUpload();
+
     // grid
-    Object gridObj;
-    gridObj.mesh = new Mesh();
-    gridObj.world = Identity;
-    gridObj.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-    gridObj.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-    gridObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-    gridObj.submesh.indexCount = grid.IndexCount();
-    scene.push_back(gridObj);
-    selectedIndex = (selectedIndex + 1) % scene.size();
-    
+    uint gridIndex = FindPrefab("grid");
+    selected = Instantiate(gridIndex);
+
+    // as linhas desenham a malha do grid com entradas prprias no buffer 
+    // constante do modelo, fora da cena
+    Prefab& gridPrefab = prefabs[gridIndex];
 
-    Object gridObjL0;
-    XMStoreFloat4x4(&gridObjL0.world,
-        XMMatrixScaling(1.0f, 1.0f, 1.0f) *
-        XMMatrixRotationZ(0.2f) *
-        XMMatrixTranslation(0.0f, 0.1f, 0.0f)
-    );
-
-    gridObjL0.mesh = new Mesh();
-    gridObjL0.world = Identity;
-    gridObjL0.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-    gridObjL0.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-    gridObjL0.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-    gridObjL0.submesh.indexCount = grid.IndexCount();
-    linhas.push_back(gridObjL0);
-
-    Object gridObjL1;
-    XMStoreFloat4x4(&gridObjL1.world,
-            XMMatrixScaling(1.0f, 1.0f, 1.0f) *
-            XMMatrixRotationZ(0.2f) *
-            XMMatrixTranslation(0.0f, 0.1f, 0.0f)
-    );
-
-    gridObjL1.mesh = new Mesh();
-    gridObjL1.world = Identity;
-    gridObjL1.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-    gridObjL1.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-    gridObjL1.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-    gridObjL1.submesh.indexCount = grid.IndexCount();
-    linhas.push_back(gridObjL1);
+    for (uint i = 0; i < 2; ++i)
+    {
+        Object gridObj;
+        gridObj.mesh = gridPrefab.mesh;
+        gridObj.prefab = gridIndex;
+        gridObj.cbIndex = gridPrefab.freeSlots.back();
+        gridPrefab.freeSlots.pop_back();
+        linhas.push_back(gridObj);
+    }
 
     /*XMMATRIX rotation = XMMatrixRotationZ(0.03f);
 
@@ -393,6 +583,8 @@ void Multi::Init()
     Object* l1 = &gridObjL1;
     XMStoreFloat4x4(&l1->world, rotation *currentWorldL1);*/
 
+    graphics->EndUpload();
+
     // ---------------------------------------
 
     BuildRootSignature();
@@ -406,257 +598,526 @@ void Multi::Init()
 
 // ------------------------------------------------------------------------------
 
-void Multi::Update()
+Handle Multi::AddObject(Object obj)
 {
-    // sai com o pressionamento da tecla ESC
-    if (input->KeyPress(VK_ESCAPE))
-        window->Close();
+    // cada objeto  um n raiz da hierarquia com a sua matriz de mundo inicial
+    Transform local = DecomposeTransform(XMLoadFloat4x4(&obj.world));
+    return AddObject(std::move(obj), local);
+}
 
-    // ativa ou desativa a quad view
-    if (input->KeyPress('V'))
-    {
-        quadView = !quadView;
-    }
-    if (input->KeyPress('R'))
+// ------------------------------------------------------------------------------
+
+Handle Multi::AddObject(Object obj, const Transform& local)
+{
+    // a matriz de mundo dos objetos da cena fica apenas na estrutura de arrays,
+    // na mesma posio do objeto no SlotMap
+    uint node = graph.Create(local);
+    obj.node = node;
+    Handle handle = scene.Insert(std::move(obj));
+
+    // identificadores de ns so reaproveitados: a entrada  apenas sobrescrita
+    if (node >= nodeObjects.size())
+        nodeObjects.resize(node + 1);
+    nodeObjects[node] = handle;
+
+    transforms.Resize(scene.Size());
+    transforms.Set(scene.Size() - 1, TransformMatrix(local));
+
+    return handle;
+}
+
+// ------------------------------------------------------------------------------
+
+bool Multi::RemoveObject(Handle handle)
+{
+    Object* obj = scene.Get(handle);
+    if (!obj)
+        return false;
+
+    uint index = scene.IndexOf(handle);
+
+    // a entrada do buffer constante volta ao modelo; a malha  do modelo
+    prefabs[obj->prefab].freeSlots.push_back(obj->cbIndex);
+
+    graph.Destroy(obj->node);
+    scene.Erase(handle);
+    transforms.Erase(index);
+
+    // o ltimo objeto ocupa a posio do removido, tambm nas estruturas de arrays
+    if (index < scene.Size())
+        scene[index].dirty = true;
+
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+uint Multi::FindPrefab(const char* name) const
+{
+    for (uint i = 0; i < prefabs.size(); ++i)
     {
-        changeTranslation = !changeTranslation;
+        if (strcmp(prefabs[i].desc->name, name) == 0)
+            return i;
     }
-    if (input->KeyPress(VK_DELETE))
+
+    return NoPrefab;
+}
+
+// ------------------------------------------------------------------------------
+
+void Multi::LoadPrefab(uint index)
+{
+    Prefab& prefab = prefabs[index];
+    if (prefab.mesh)
+        return;
+
+    // arquivos so lidos e otimizados apenas uma vez
+    if (prefab.desc->file)
+        prefab.geo = LoadOBJ(prefab.desc->file);
+
+    // vrtices e ndices enviados  GPU uma nica vez para todas as instncias
+    prefab.mesh = new Mesh();
+    prefab.mesh->VertexBuffer<SceneVertex>(prefab.geo, splitPositions);
+    prefab.mesh->IndexBuffer(prefab.geo.IndexBufferData(), prefab.geo.IndexBufferSize(), prefab.geo.IndexFormat());
+    prefab.mesh->bounds = prefab.geo.bounds;
+}
+
+// ------------------------------------------------------------------------------
+
+void Multi::GrowPrefab(uint index, uint capacity)
+{
+    Prefab& prefab = prefabs[index];
+    if (capacity <= prefab.capacity)
+        return;
+
+    // o buffer novo substitui o anterior: as instncias existentes copiam
+    // as suas constantes de novo no prximo Update
+    prefab.mesh->ConstantBuffer(sizeof(ObjectConstants), capacity);
+
+    if (prefab.capacity > 0)
     {
-        if (selectedIndex >= 0 && selectedIndex < scene.size())
+        for (Object& obj : scene)
         {
-            delete scene[selectedIndex].mesh;
-            scene.erase(scene.begin() + selectedIndex);
+            if (obj.prefab == index)
+                obj.dirty = true;
+        }
 
-            if (!scene.empty())
-            {
-                selectedIndex = selectedIndex % scene.size();
-                selectedObj = &scene[selectedIndex];
-            }
-            else
-            {
-                selectedIndex = -1;
-                selectedObj = nullptr;
-            }
+        for (Object& obj : linhas)
+        {
+            if (obj.prefab == index)
+                obj.dirty = true;
         }
     }
-    graphics->ResetCommands();
 
-    if (input->KeyPress('Q')) {
+    // entradas novas empilhadas de forma que as menores saiam primeiro
+    for (uint slot = capacity; slot > prefab.capacity; --slot)
+        prefab.freeSlots.push_back(slot - 1);
+
+    prefab.capacity = capacity;
+}
+
+// ------------------------------------------------------------------------------
+
+Handle Multi::Instantiate(uint index)
+{
+    const PrefabDesc& desc = *prefabs[index].desc;
 
-        Object quadObj;
-        XMStoreFloat4x4(&quadObj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
+    Transform local;
+    local.translation = XMFLOAT3(0.0f, desc.height, 0.0f);
+    local.scale = XMFLOAT3(desc.scale, desc.scale, desc.scale);
 
-        quadObj.mesh = new Mesh();
-        quadObj.mesh->VertexBuffer(quad.VertexData(), quad.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        quadObj.mesh->IndexBuffer(quad.IndexData(), quad.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        quadObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        quadObj.submesh.indexCount = quad.IndexCount();
-        scene.push_back(quadObj);
+    return Instantiate(index, local);
+}
 
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+// ------------------------------------------------------------------------------
 
-    }
+Handle Multi::Instantiate(uint index, const Transform& local)
+{
+    LoadPrefab(index);
+
+    Prefab& prefab = prefabs[index];
+
+    // buffer constante cheio: dobra a capacidade
+    if (prefab.freeSlots.empty())
+        GrowPrefab(index, prefab.capacity ? prefab.capacity * 2 : 16);
 
-    if (input->KeyPress('B')) {
-        // box
-        Object boxObj;
-        XMStoreFloat4x4(&boxObj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
+    // sub-malhas, nveis e meshlets ficam no modelo: o objeto guarda
+    // apenas o ndice do modelo e o seu estado prprio
+    Object obj;
+    obj.mesh = prefab.mesh;
+    obj.prefab = index;
+    obj.cbIndex = prefab.freeSlots.back();
 
-        boxObj.mesh = new Mesh();
-        boxObj.mesh->VertexBuffer(box.VertexData(), box.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        boxObj.mesh->IndexBuffer(box.IndexData(), box.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        boxObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        boxObj.submesh.indexCount = box.IndexCount();
-        scene.push_back(boxObj);
+    prefab.freeSlots.pop_back();
+    return AddObject(std::move(obj), local);
+}
 
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+// ------------------------------------------------------------------------------
 
+vector<Handle> Multi::SpawnBatch(const vector<SpawnRequest>& requests)
+{
+    // instncias de cada modelo: o buffer constante cresce no mximo uma vez
+    vector<uint> counts(prefabs.size(), 0);
+    for (const SpawnRequest& request : requests)
+        ++counts[request.prefab];
+
+    // geometria de modelos ainda no residentes em um nico buffer de upload,
+    // enviada junto com os demais comandos do quadro
+    graphics->BeginUpload();
+
+    for (uint i = 0; i < prefabs.size(); ++i)
+    {
+        if (counts[i] == 0)
+            continue;
+
+        LoadPrefab(i);
+
+        Prefab& prefab = prefabs[i];
+        uint available = uint(prefab.freeSlots.size());
+        if (counts[i] > available)
+        {
+            uint needed = prefab.capacity + counts[i] - available;
+            GrowPrefab(i, needed > prefab.capacity * 2 ? needed : prefab.capacity * 2);
+        }
     }
 
-    if (input->KeyPress('C')) {
-        // cylinder
-        Object cylinderObj;
-        XMStoreFloat4x4(&cylinderObj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.75f, 0.0f));
+    graphics->EndUpload();
+
+    // reserva geomtrica: lotes seguidos no realocam e copiam a cena inteira 
+    // a cada chamada, como aconteceria reservando apenas o tamanho exato
+    // (o TransformStore j cresce em potncias de 2)
+    uint total = uint(requests.size());
+    uint needed = scene.Size() + total;
+    if (needed > scene.Capacity())
+    {
+        uint capacity = scene.Capacity() * 2;
+        if (capacity < needed)
+            capacity = needed;
+
+        scene.Reserve(capacity);
+        graph.Reserve(capacity);
+    }
 
-        cylinderObj.mesh = new Mesh();
-        cylinderObj.mesh->VertexBuffer(cylinder.VertexData(), cylinder.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        cylinderObj.mesh->IndexBuffer(cylinder.IndexData(), cylinder.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        cylinderObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        cylinderObj.submesh.indexCount = cylinder.IndexCount();
-        scene.push_back(cylinderObj);
+    vector<Handle> handles;
+    handles.reserve(total);
 
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+    for (const SpawnRequest& request : requests)
+        handles.push_back(Instantiate(request.prefab, request.local));
 
+    return handles;
+}
+
+// ------------------------------------------------------------------------------
+
+// transformao de um objeto do modo de estresse no instante time
+static Transform StressPose(const StressMotion& motion, float time)
+{
+    Transform t;
+    t.translation = motion.center;
+    t.scale = XMFLOAT3(motion.scale, motion.scale, motion.scale);
+
+    float angle = motion.phase + motion.speed * time;
+
+    switch (motion.pattern)
+    {
+    case STRESS_ORBIT:
+        t.translation.x += motion.radius * cosf(angle);
+        t.translation.z += motion.radius * sinf(angle);
+        break;
+    case STRESS_BOB:
+        t.translation.y += motion.radius * sinf(angle);
+        break;
+    case STRESS_SPIN:
+        XMStoreFloat4(&t.rotation, XMQuaternionRotationRollPitchYaw(0.0f, angle, 0.0f));
+        break;
     }
 
-    if (input->KeyPress('S')) {
-        // sphere
-        Object sphereObj;
-        XMStoreFloat4x4(&sphereObj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
+    return t;
+}
+
+// ------------------------------------------------------------------------------
 
-        sphereObj.mesh = new Mesh();
-        sphereObj.mesh->VertexBuffer(sphere.VertexData(), sphere.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        sphereObj.mesh->IndexBuffer(sphere.IndexData(), sphere.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        sphereObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        sphereObj.submesh.indexCount = sphere.IndexCount();
-        scene.push_back(sphereObj);
+void Multi::StartStress()
+{
+    // semente fixa: a mesma cena e a mesma troca em todas as execues
+    stressRandom.seed(2026);
+    stressTime = 0.0f;
+    stressDebt = 0.0f;
 
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+    stressPrefabs.clear();
+    for (const char* name : { "box", "cylinder", "sphere", "geoSphere", "ball", "capsule", "monkey", "thorus" })
+        stressPrefabs.push_back(FindPrefab(name));
 
+    stressMotions.reserve(stressCount);
+    SpawnStress(stressCount);
+
+    stress = true;
+}
+
+// ------------------------------------------------------------------------------
+
+void Multi::StopStress()
+{
+    while (!stressMotions.empty())
+        RemoveStress(uint(stressMotions.size()) - 1);
+
+    if (!scene.Contains(selected))
+        selected = scene.Empty() ? Handle() : scene.HandleAt(0);
+
+    stress = false;
+}
+
+// ------------------------------------------------------------------------------
+
+void Multi::SpawnStress(uint count)
+{
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // rea proporcional ao nmero de objetos: a densidade no muda com stressCount
+    float extent = 0.1f * sqrtf(float(stressCount));
+
+    uint first = uint(stressMotions.size());
+    vector<SpawnRequest> requests(count);
+
+    for (SpawnRequest& request : requests)
+    {
+        StressMotion motion;
+        motion.center = XMFLOAT3((unit(stressRandom) * 2.0f - 1.0f) * extent, 
+            unit(stressRandom) * 4.0f, (unit(stressRandom) * 2.0f - 1.0f) * extent);
+        motion.radius = 0.2f + unit(stressRandom);
+        motion.speed = 0.5f + 2.0f * unit(stressRandom);
+        motion.phase = XM_2PI * unit(stressRandom);
+        motion.scale = 0.05f + 0.15f * unit(stressRandom);
+        motion.pattern = stressRandom() % STRESS_PATTERNS;
+
+        request.prefab = stressPrefabs[stressRandom() % stressPrefabs.size()];
+        request.local = StressPose(motion, stressTime);
+        stressMotions.push_back(motion);
     }
 
-    if (input->KeyPress('G')) {
-        // geo sphere
-        Object geoSphereObj;
-        XMStoreFloat4x4(&geoSphereObj.world,
-            XMMatrixScaling(0.5f, 0.5f, 0.5f) *
-            XMMatrixTranslation(0.0f, 0.5f, 0.0f));
+    vector<Handle> handles = SpawnBatch(requests);
+
+    for (uint i = 0; i < count; ++i)
+        stressMotions[first + i].object = handles[i];
+}
+
+// ------------------------------------------------------------------------------
+
+void Multi::RemoveStress(uint index)
+{
+    // o objeto pode j ter sido removido pela tecla DELETE
+    RemoveObject(stressMotions[index].object);
+
+    stressMotions[index] = stressMotions.back();
+    stressMotions.pop_back();
+}
 
-        geoSphereObj.mesh = new Mesh();
-        geoSphereObj.mesh->VertexBuffer(geoSphere.VertexData(), geoSphere.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        geoSphereObj.mesh->IndexBuffer(geoSphere.IndexData(), geoSphere.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        geoSphereObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        geoSphereObj.submesh.indexCount = geoSphere.IndexCount();
-        scene.push_back(geoSphereObj);
+// ------------------------------------------------------------------------------
 
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+void Multi::AnimateStress(float dt)
+{
+    stressTime += dt;
 
+    // objetos parados no so tocados e continuam limpos
+    for (const StressMotion& motion : stressMotions)
+    {
+        if (motion.pattern == STRESS_STATIC)
+            continue;
+
+        if (const Object* obj = scene.Get(motion.object))
+            graph.SetLocal(obj->node, StressPose(motion, stressTime));
     }
 
-    if (input->KeyPress('P')) {
-        // grid
-        Object gridObj;
-        gridObj.mesh = new Mesh();
-        gridObj.world = Identity;
-        gridObj.mesh->VertexBuffer(grid.VertexData(), grid.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        gridObj.mesh->IndexBuffer(grid.IndexData(), grid.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        gridObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        gridObj.submesh.indexCount = grid.IndexCount();
-        scene.push_back(gridObj);
+    // troca: objetos sorteados so removidos e outros so criados no lugar
+    stressDebt += stressChurn * dt;
+    uint churn = uint(stressDebt);
+    stressDebt -= float(churn);
+
+    churn = churn < stressMotions.size() ? churn : uint(stressMotions.size());
 
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+    for (uint i = 0; i < churn; ++i)
+        RemoveStress(stressRandom() % uint(stressMotions.size()));
+
+    // quadros sem troca no montam lote nem abrem o buffer de upload
+    if (churn)
+        SpawnStress(churn);
+}
 
+// ------------------------------------------------------------------------------
+
+void Multi::Update()
+{
+    profiler.Begin();
+
+    // tempo do quadro anterior, limitado para que uma pausa longa
+    // no vire um salto na animao ou uma rajada de trocas
+    float dt = float(timer.Reset());
+    dt = dt > 0.1f ? 0.1f : dt;
+
+    // sai com o pressionamento da tecla ESC
+    if (input->KeyPress(VK_ESCAPE))
+        window->Close();
+
+    // ativa ou desativa a quad view
+    if (input->KeyPress('V'))
+    {
+        quadView = !quadView;
+    }
+    if (input->KeyPress('R'))
+    {
+        changeTranslation = !changeTranslation;
     }
+    if (input->KeyPress(VK_DELETE))
+    {
+        if (scene.Contains(selected))
+        {
+            uint index = scene.IndexOf(selected);
+            RemoveObject(selected);
 
-    if (input->KeyPress('1')) {
-        // Carregar o arquivo .obj
-        ObjData ballData = LoadOBJ("ball.obj");
-
-        Object ballDataObj;
-        ballDataObj.mesh = new Mesh();
-        ballDataObj.world = Identity;
-        ballDataObj.mesh->VertexBuffer(ballData.VertexData(), ballData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        ballDataObj.mesh->IndexBuffer(ballData.IndexData(), ballData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        ballDataObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        ballDataObj.submesh.indexCount = ballData.IndexCount();
-        scene.push_back(ballDataObj);
-
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back(); 
+            // o ltimo objeto ocupa a posio do removido e passa a ser o selecionado
+            selected = scene.Empty() ? Handle() : scene.HandleAt(index % scene.Size());
+        }
     }
-    if (input->KeyPress('2')) {
-        // Carregar o arquivo .obj
-        ObjData capsuleData = LoadOBJ("capsule.obj");
-
-        Object capsuleDataObj;
-        capsuleDataObj.mesh = new Mesh();
-        capsuleDataObj.world = Identity;
-        capsuleDataObj.mesh->VertexBuffer(capsuleData.VertexData(), capsuleData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        capsuleDataObj.mesh->IndexBuffer(capsuleData.IndexData(), capsuleData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        capsuleDataObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        capsuleDataObj.submesh.indexCount = capsuleData.IndexCount();
-        scene.push_back(capsuleDataObj);
-
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+    graphics->ResetCommands();
+
+    // uma instncia do modelo de cada tecla: a geometria j est na GPU e o
+    // objeto recebe apenas uma entrada no buffer constante do modelo
+    for (uint i = 0; i < prefabs.size(); ++i)
+    {
+        if (prefabs[i].desc->key && input->KeyPress(prefabs[i].desc->key))
+            selected = Instantiate(i);
     }
-    if (input->KeyPress('3')) {
-        // Carregar o arquivo .obj
-        ObjData houseData = LoadOBJ("house.obj");
-
-        Object houseDataObj;
-        houseDataObj.mesh = new Mesh();
-        houseDataObj.world = Identity;
-        houseDataObj.mesh->VertexBuffer(houseData.VertexData(), houseData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        houseDataObj.mesh->IndexBuffer(houseData.IndexData(), houseData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        houseDataObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        houseDataObj.submesh.indexCount = houseData.IndexCount();
-        scene.push_back(houseDataObj);
-
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+
+    if (input->KeyPress('7')) {
+        // objetos estticos: as primitivas so levadas ao espao do mundo e 
+        // combinadas em um nico vertex buffer, index buffer e desenho;
+        // o lote vira um modelo e os pedidos seguintes apenas o instanciam
+        uint index = FindPrefab(PropsDesc.name);
+        if (index == NoPrefab)
+        {
+            Geometry props;
+            const Geometry* shapes[] = { &prefabs[FindPrefab("box")].geo, &prefabs[FindPrefab("cylinder")].geo,
+                &prefabs[FindPrefab("sphere")].geo, &prefabs[FindPrefab("geoSphere")].geo };
+            const int side = 16;
+
+            // erro mximo aceito no espao do mundo ao escolher o nvel de cada parte
+            const float tolerance = 0.002f;
+
+            for (int i = 0; i < side; ++i)
+            {
+                for (int j = 0; j < side; ++j)
+                {
+                    float scale = 0.1f + 0.05f * ((i * 7 + j * 3) % 4);
+                    const Geometry& shape = *shapes[(i + j) % 4];
+                    props.Append(shape,
+                        XMMatrixScaling(scale, scale, scale) *
+                        XMMatrixRotationY(0.4f * (i * side + j)) *
+                        XMMatrixTranslation((i - side / 2) * 0.6f, scale * 1.5f, (j - side / 2) * 0.6f),
+                        SelectLod(shape.lods, scale, tolerance));
+                }
+            }
+
+            // as partes j vm otimizadas; meshlets permitem descartar 
+            // pedaos do lote que estejam fora da vista
+            props.BuildPositionStream();
+            props.BuildMeshlets();
+            props.OptimizeVertexFetch();
+            props.PackIndices();
+            props.ComputeBounds();
+
+            Prefab prefab;
+            prefab.desc = &PropsDesc;
+            prefab.geo = std::move(props);
+            prefabs.push_back(std::move(prefab));
+            index = uint(prefabs.size()) - 1;
+        }
+
+        selected = Instantiate(index);
     }
-    if (input->KeyPress('4')) {
-        // Carregar o arquivo .obj
-        ObjData monkeyData = LoadOBJ("monkey.obj");
-
-        Object monkeyDataObj;
-        monkeyDataObj.mesh = new Mesh();
-        monkeyDataObj.world = Identity;
-        monkeyDataObj.mesh->VertexBuffer(monkeyData.VertexData(), monkeyData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        monkeyDataObj.mesh->IndexBuffer(monkeyData.IndexData(), monkeyData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        monkeyDataObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        monkeyDataObj.submesh.indexCount = monkeyData.IndexCount();
-        scene.push_back(monkeyDataObj);
-
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+
+    if (input->KeyPress('T')) {
+        // terreno em peas com nveis de detalhe escolhidos por vista
+        if (!terrain)
+        {
+            terrain = new Terrain(GenerateHeightmap(257, 257, 4.0f), 0.25f, 32);
+            terrain->ComputeBounds();
+
+            XMStoreFloat4x4(&terrainObj.world, XMMatrixTranslation(0.0f, -3.0f, 0.0f));
+            terrainObj.mesh = new Mesh();
+            terrainObj.mesh->VertexBuffer<SceneVertex>(*terrain, splitPositions);
+            terrainObj.mesh->IndexBuffer(terrain->IndexBufferData(), terrain->IndexBufferSize(), terrain->IndexFormat());
+            terrainObj.mesh->ConstantBuffer(sizeof(ObjectConstants));
+            terrainObj.mesh->bounds = terrain->bounds;
+        }
+
+        showTerrain = !showTerrain;
+        terrainObj.dirty = true;
     }
-    if (input->KeyPress('5')) {
-        // Carregar o arquivo .obj
-        ObjData thorusData = LoadOBJ("thorus.obj");
-
-        Object thorusDataObj;
-        thorusDataObj.mesh = new Mesh();
-        thorusDataObj.world = Identity;
-        thorusDataObj.mesh->VertexBuffer(thorusData.VertexData(), thorusData.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        thorusDataObj.mesh->IndexBuffer(thorusData.IndexData(), thorusData.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        thorusDataObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        thorusDataObj.submesh.indexCount = thorusData.IndexCount();
-        scene.push_back(thorusDataObj);
-
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+
+    // espalha instncias do modelo do objeto selecionado em um nico lote
+    if (input->KeyPress('N')) {
+        const Object* obj = scene.Get(selected);
+        uint prefab = (obj && obj->prefab != NoPrefab) ? obj->prefab : FindPrefab("box");
+
+        // espiral de ngulo ureo: pontos distribudos por igual em um disco
+        vector<SpawnRequest> requests(ScatterCount);
+        for (uint i = 0; i < ScatterCount; ++i)
+        {
+            float r = 0.25f * sqrtf(float(i));
+            float angle = 2.39996f * i;
+
+            requests[i].prefab = prefab;
+            requests[i].local.translation = XMFLOAT3(r * cosf(angle), 0.1f, r * sinf(angle));
+            requests[i].local.scale = XMFLOAT3(0.1f, 0.1f, 0.1f);
+        }
+
+        llong start = timer.Stamp();
+        SpawnBatch(requests);
+
+        std::ostringstream text;
+        text.precision(3);
+        text << std::fixed << "Lote de " << ScatterCount << " objetos: " << timer.Elapsed(start) * 1000.0 << " ms\n";
+        OutputDebugString(text.str().c_str());
     }
-    if (input->KeyPress('6')) {
-        // Carregar o arquivo .obj
-        ObjData data = LoadOBJ("plane.obj");
-
-        Object dataObj;
-        dataObj.mesh = new Mesh();
-        dataObj.world = Identity;
-        dataObj.mesh->VertexBuffer(data.VertexData(), data.VertexCount() * sizeof(Vertex), sizeof(Vertex));
-        dataObj.mesh->IndexBuffer(data.IndexData(), data.IndexCount() * sizeof(uint), DXGI_FORMAT_R32_UINT);
-        dataObj.mesh->ConstantBuffer(sizeof(ObjectConstants), 4);
-        dataObj.submesh.indexCount = data.IndexCount();
-        scene.push_back(dataObj);
-
-        selectedIndex = scene.size() - 1;
-        selectedObj = &scene.back();
+
+    // modo de estresse: muitos objetos animados, com criao e remoo contnuas
+    if (input->KeyPress('E')) {
+        if (stress)
+            StopStress();
+        else
+            StartStress();
+    }
+
+    // nmero de objetos do modo de estresse (vale na prxima ativao)
+    if (input->KeyPress(VK_OEM_MINUS) && stressCount > 1000) {
+        stressCount /= 2;
+        OutputDebugString(("Objetos de estresse: " + std::to_string(stressCount) + "\n").c_str());
+    }
+    if (input->KeyPress(VK_OEM_PLUS) && stressCount < 1600000) {
+        stressCount *= 2;
+        OutputDebugString(("Objetos de estresse: " + std::to_string(stressCount) + "\n").c_str());
     }
 
     float mousePosX = (float)input->MouseX();
     float mousePosY = (float)input->MouseY();
     
-    if (input->KeyPress(VK_TAB)) {
-        if (scene.empty()) return;
-        selectedIndex = (selectedIndex + 1) % scene.size();
-        selectedObj = &scene[selectedIndex];
+    if (input->KeyPress(VK_TAB) && !scene.Empty()) {
+        uint next = scene.Contains(selected) ? scene.IndexOf(selected) + 1 : 0;
+        selected = scene.HandleAt(next % scene.Size());
+    }
+
+    // prende o objeto selecionado ao selecionado antes dele (mantendo a posio no mundo)
+    if (input->KeyPress('A')) {
+        Object* child = scene.Get(selected);
+        Object* parent = scene.Get(previous);
+        if (child && parent)
+            graph.SetParent(child->node, parent->node);
+    }
+
+    // solta o objeto selecionado do seu pai
+    if (input->KeyPress('D')) {
+        if (Object* child = scene.Get(selected))
+            graph.SetParent(child->node, NoNode);
     }
 
     if (input->KeyDown(VK_LBUTTON))
@@ -732,48 +1193,58 @@ void Multi::Update()
     // carrega matriz de projeo em uma XMMATRIX
     XMMATRIX proj = XMLoadFloat4x4(&Proj);
 
-    // modifica matriz de mundo do objeto selecionado
-    if (selectedIndex != -1) {
+    // modifica posio, rotao e escala (relativas ao pai) do objeto selecionado:
+    // cada componente  alterado diretamente, sem acumular erro em produtos de matrizes
+    Object* selectedObj = scene.Get(selected);
+    if (!scene.Empty()) {
         if (selectedObj != nullptr) {
 
-            // Carrega a matriz de mundo atual do objeto
-            XMMATRIX currentWorld = XMLoadFloat4x4(&selectedObj->world);
-
-            XMVECTOR scale, rotation, translation;
-            XMMatrixDecompose(&scale, &rotation, &translation, currentWorld);
-
-            // para girar o objeto (opcional)
-            //currentWorld *= XMMatrixRotationY(float(timer.Elapsed())); 
+            // Carrega a transformao local atual do objeto
+            const Transform& current = graph.Local(selectedObj->node);
+            XMVECTOR translation = XMLoadFloat3(&current.translation);
+            XMVECTOR rotation = XMLoadFloat4(&current.rotation);
+            float scaling = 1.0f;
+
+            // gira em torno de um eixo do prprio objeto; a normalizao
+            // mantm o quaternion unitrio apesar das rotaes repetidas
+            auto rotate = [&rotation](FXMVECTOR axis, float angle) {
+                rotation = XMQuaternionNormalize(
+                    XMQuaternionMultiply(XMQuaternionRotationNormal(axis, angle), rotation));
+            };
+
+            const XMVECTOR axisX = XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+            const XMVECTOR axisY = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+            const XMVECTOR axisZ = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
             
             if (changeTranslation) {
                 // Move no eixo X com setas esquerda/direita
                 if (input->KeyDown(VK_LEFT)) {
-                    currentWorld *= XMMatrixTranslation(0.05f, 0.0f, 0.0f);
+                    translation += XMVectorSet(0.05f, 0.0f, 0.0f, 0.0f);
                 }
                 if (input->KeyDown(VK_RIGHT)) {
-                    currentWorld *= XMMatrixTranslation(-0.05f, 0.0f, 0.0f);
+                    translation += XMVectorSet(-0.05f, 0.0f, 0.0f, 0.0f);
                 }
                 // Move no eixo Z com setas cima/baixo
                 if (input->KeyDown(VK_UP)) {
-                    currentWorld *= XMMatrixTranslation(0.0f, 0.0f, -0.05f);
+                    translation += XMVectorSet(0.0f, 0.0f, -0.05f, 0.0f);
                 }
                 if (input->KeyDown(VK_DOWN)) {
-                    currentWorld *= XMMatrixTranslation(0.0f, 0.0f, 0.05f);
+                    translation += XMVectorSet(0.0f, 0.0f, 0.05f, 0.0f);
                 }
                 // Move no eixo Y com Ctrl (descer) e Shift (subir)
                 if (input->KeyDown(VK_SHIFT)) {
-                    currentWorld *= XMMatrixTranslation(0.0f, 0.05f, 0.0f);
+                    translation += XMVectorSet(0.0f, 0.05f, 0.0f, 0.0f);
                 }
                 if (input->KeyDown(VK_CONTROL)) {
-                    currentWorld *= XMMatrixTranslation(0.0f, -0.05f, 0.0f);
+                    translation += XMVectorSet(0.0f, -0.05f, 0.0f, 0.0f);
                 }
             }
             // escala
             if (input->KeyDown('X')) {
-                currentWorld = XMMatrixScaling(1.01f, 1.01f, 1.01f) * currentWorld;
+                scaling *= 1.01f;
             }
             if (input->KeyDown('Z')) {
-                currentWorld = XMMatrixScaling(0.99f, 0.99f, 0.99f) * currentWorld;
+                scaling *= 0.99f;
             }
 
             //  rotao
@@ -781,33 +1252,66 @@ void Multi::Update()
 
                 // Move no eixo Z
                 if (input->KeyDown(VK_LEFT)) {
-                    currentWorld = XMMatrixRotationZ(-0.05f) * currentWorld;
+                    rotate(axisZ, -0.05f);
                 }
                 if (input->KeyDown(VK_RIGHT)) {
-                    currentWorld = XMMatrixRotationZ(0.05f) * currentWorld;
+                    rotate(axisZ, 0.05f);
                 }
                 // Move no eixo X com setas cima/baixo
                 if (input->KeyDown(VK_UP)) {
-                    currentWorld = XMMatrixRotationX(-0.05f) * currentWorld;
+                    rotate(axisX, -0.05f);
                 }
                 if (input->KeyDown(VK_DOWN)) {
-                    currentWorld = XMMatrixRotationX(0.05f) * currentWorld;
+                    rotate(axisX, 0.05f);
                 }
                 // Move no eixo Y com Ctrl (Horario) e Shift (Anti-horario)
                 if (input->KeyDown(VK_SHIFT)) {
-                    currentWorld = XMMatrixRotationY(-0.05f) * currentWorld;
+                    rotate(axisY, -0.05f);
                 }
                 if (input->KeyDown(VK_CONTROL)) {
-                    currentWorld = XMMatrixRotationY(0.05f) * currentWorld;
+                    rotate(axisY, 0.05f);
                 }
             }
 
+            Transform edited;
+            XMStoreFloat3(&edited.translation, translation);
+            XMStoreFloat4(&edited.rotation, rotation);
+            XMStoreFloat3(&edited.scale, XMLoadFloat3(&current.scale) * scaling);
 
-            XMStoreFloat4x4(&selectedObj->world, currentWorld);
+            // s a edio que de fato altera um componente suja a subrvore do objeto
+            if (memcmp(&edited, &current, sizeof(Transform)) != 0)
+                graph.SetLocal(selectedObj->node, edited);
         }
 
     }
 
+    profiler.Mark("entrada");
+
+    if (stress)
+    {
+        AnimateStress(dt);
+
+        // a troca pode ter removido o objeto selecionado ou realocado a cena
+        if (!scene.Contains(selected))
+            selected = scene.Empty() ? Handle() : scene.HandleAt(0);
+
+        selectedObj = scene.Get(selected);
+    }
+
+    profiler.Mark("estresse");
+
+    // matrizes de mundo refeitas apenas nas subrvores alteradas; apenas os
+    // objetos cujo mundo mudou so visitados e refazem constantes, volumes
+    // e nveis de detalhe
+    for (uint node : graph.Update())
+    {
+        uint i = scene.IndexOf(nodeObjects[node]);
+        transforms.Set(i, graph.World(node));
+        scene[i].dirty = true;
+    }
+
+    profiler.Mark("hierarquia");
+
     // ajusta o buffer constante de cada objeto
     XMMATRIX projOrtFront = XMLoadFloat4x4(&ProjOrtFront);
     XMMATRIX viewOrtFront = XMLoadFloat4x4(&ViewOrtFront);
@@ -816,117 +1320,341 @@ void Multi::Update()
     XMMATRIX projOrtTop = XMLoadFloat4x4(&ProjOrtTop);
     XMMATRIX viewOrtTop = XMLoadFloat4x4(&ViewOrtTop);
 
-    OutputDebugString(("Tamanho da cena: " + std::to_string(scene.size()) + "\n").c_str());
-    for (auto & obj : scene)
+    XMMATRIX views[4] = { view, viewOrtFront, viewOrtSide, viewOrtTop };
+    XMMATRIX projs[4] = { proj, projOrtFront, projOrtSide, projOrtTop };
+    float heights[4] = { quadView ? viewPortPers.Height : viewPortTotal.Height,
+        viewPortOrtFront.Height, viewPortOrtSide.Height, viewPortOrtTop.Height };
+
+    XMMATRIX viewProjections[TransformStore::Views] =
+    {
+        view * proj,
+        viewOrtFront * projOrtFront,
+        viewOrtSide * projOrtSide,
+        viewOrtTop * projOrtTop
+    };
+
+    // vistas desenhadas neste quadro: fora da quad view, apenas a perspectiva
+    bool active[TransformStore::Views] = { true, quadView, quadView, quadView };
+
+    // uma vista est suja quando sua cmera ou a altura da sua viewport mudou,
+    // ou quando volta a ser desenhada: o descarte, o nvel de detalhe e os
+    // meshlets visveis dependem das trs
+    bool anyViewDirty = false;
+    for (uint v = 0; v < TransformStore::Views; ++v)
+    {
+        ViewConstants constants;
+        XMStoreFloat4x4(&constants.ViewProj, XMMatrixTranspose(viewProjections[v]));
+
+        viewDirty[v] = memcmp(&constants, &viewConstants[v], sizeof(ViewConstants)) != 0
+            || heights[v] != viewHeights[v] || (active[v] && !viewActive[v]);
+
+        viewConstants[v] = constants;
+        viewHeights[v] = heights[v];
+        viewActive[v] = active[v];
+        anyViewDirty |= viewDirty[v];
+    }
+
+    // a troca de seleo muda a cor do objeto antes e depois selecionado
+    if (selected != painted)
+    {
+        if (Object* obj = scene.Get(painted))
+            obj->dirty = true;
+
+        if (selectedObj)
+            selectedObj->dirty = true;
+
+        previous = painted;
+        painted = selected;
+    }
+
+    // apenas volumes de mundo alterados so copiados para a estrutura de
+    // arrays do descarte; o produto em lotes SIMD refaz s as vistas e os
+    // lotes de matrizes que mudaram
+    bool anyObjectDirty = false;
+    bool resized = culling.Count() != scene.Size();
+    culling.Resize(scene.Size());
+    for (uint i = 0; i < scene.Size(); ++i)
+    {
+        Object& obj = scene[i];
+        if (obj.dirty)
+        {
+            // volumes envolventes levados ao espao do mundo
+            obj.worldBounds = TransformBounds(obj.mesh->bounds, transforms.World(i));
+            culling.Set(i, obj.worldBounds);
+
+            anyObjectDirty = true;
+        }
+    }
+
+    if (anyObjectDirty || anyViewDirty)
+        transforms.Compute(viewProjections, viewActive);
+
+    profiler.Mark("transformacoes");
+
+    // listas de visveis de todas as vistas ativas em uma passagem, refeitas
+    // quando um objeto, uma vista ou o tamanho da cena mudou
+    if (anyObjectDirty || anyViewDirty || resized)
+        culling.Cull(viewProjections, viewActive, visibleObjects);
+
+    for (uint v = 0; v < TransformStore::Views; ++v)
+        culledObjects[v] = viewActive[v] ? scene.Size() - uint(visibleObjects[v].size()) : 0;
+
+    profiler.Mark("descarte");
+
+    // nvel de detalhe e meshlets apenas dos objetos visveis em cada vista;
+    // um objeto que entra na vista est sujo ou a vista mudou
+    for (uint v = 0; v < TransformStore::Views; ++v)
+    {
+        if (!viewActive[v])
+            continue;
+
+        for (uint i : visibleObjects[v])
+        {
+            Object& obj = scene[i];
+
+            // objeto parado em vista parada: nada a refazer
+            if (!obj.dirty && !viewDirty[v])
+                continue;
+
+            XMMATRIX world = transforms.World(i);
+
+            // nvel de detalhe da vista pelo tamanho do objeto na tela, com
+            // histerese para no alternar entre dois nveis perto do limite
+            const Geometry& geo = prefabs[obj.prefab].geo;
+            obj.lod[v] = SelectLod(geo.lods, PixelsPerUnit(world, views[v], projs[v], heights[v]), 1.0f, obj.lod[v]);
+
+            // no nvel mais detalhado, apenas meshlets visveis so desenhados;
+            // a matriz combinada (world x view x proj) vem do clculo em lote
+            if (obj.lod[v] == 0 && !geo.meshletDraws.empty())
+                CullMeshlets(obj.visible[v], geo.meshletDraws, geo.meshletBounds,
+                    ComputeMeshletFrustum(transforms.WorldViewProj(v, i)));
+        }
+    }
+
+    updatedObjects = 0;
+
+    for (uint i = 0; i < scene.Size(); ++i)
     {   
-        // carrega matriz de mundo em uma XMMATRIX
-        XMMATRIX world = XMLoadFloat4x4(&obj.world);      
+        // o buffer constante do objeto no depende das vistas
+        Object& obj = scene[i];
+        if (!obj.dirty)
+            continue;
 
-        // constri matriz combinada (world x view x proj)
-        XMMATRIX WorldViewProj = world * view * proj;
-        XMMATRIX WorldViewProjFront = world * viewOrtFront * projOrtFront;
-        XMMATRIX WorldViewProjSide = world * viewOrtSide * projOrtSide;
-        XMMATRIX WorldViewProjTop = world * viewOrtTop * projOrtTop;
+        // a GPU recebe posies quantizadas; a descompresso entra na matriz de mundo
+        XMMATRIX world = transforms.World(i);
+        XMMATRIX dequantize = XMLoadFloat4x4(&obj.mesh->dequantize);
 
         bool isSelected = (&obj == selectedObj);
         XMVECTOR color = isSelected ? DirectX::Colors::Red : DirectX::Colors::DimGray;
 
-        // atualiza o buffer constante com a matriz combinada
+        // atualiza o buffer constante do objeto, compartilhado pelas quatro vistas
         ObjectConstants constants;
-
-        XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProj));
+        XMStoreFloat4x4(&constants.World, XMMatrixTranspose(dequantize * world));
         XMStoreFloat4(&constants.objColor, color);
-        obj.mesh->CopyConstants(&constants, 0);
+        obj.mesh->CopyConstants(&constants, obj.cbIndex);
 
-        XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProjFront));
-        XMStoreFloat4(&constants.objColor, color);
-        obj.mesh->CopyConstants(&constants, 1);
+        obj.dirty = false;
+        ++updatedObjects;
+    }
 
-        XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProjSide));
-        XMStoreFloat4(&constants.objColor, color);
-        obj.mesh->CopyConstants(&constants, 2);
+    profiler.Mark("objetos");
 
-        XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProjTop));
-        XMStoreFloat4(&constants.objColor, color);
-        obj.mesh->CopyConstants(&constants, 3);
+    OutputDebugString(("Tamanho da cena: " + std::to_string(scene.Size()) +
+        ", objetos atualizados: " + std::to_string(updatedObjects) + 
+        ", descartados por vista: " + std::to_string(culledObjects[0]) + "/" + std::to_string(culledObjects[1]) + 
+        "/" + std::to_string(culledObjects[2]) + "/" + std::to_string(culledObjects[3]) + "\n").c_str());
+
+    // terreno: cada vista escolhe o nvel das peas pelo erro projetado na tela
+    if (showTerrain)
+    {
+        XMMATRIX world = XMLoadFloat4x4(&terrainObj.world);
+
+        for (uint v = 0; v < 4; ++v)
+        {
+            if (!terrainObj.dirty && !viewDirty[v])
+                continue;
+
+            XMMATRIX worldViewProj = world * views[v] * projs[v];
+            terrain->SelectChunks(terrainObj.visible[v], worldViewProj, 
+                XMVectorGetY(projs[v].r[1]) * 0.5f * heights[v], 1.0f, terrainBudget);
+        }
+
+        if (terrainObj.dirty)
+        {
+            XMMATRIX dequantize = XMLoadFloat4x4(&terrainObj.mesh->dequantize);
+
+            ObjectConstants constants;
+            XMStoreFloat4x4(&constants.World, XMMatrixTranspose(dequantize * world));
+            XMStoreFloat4(&constants.objColor, DirectX::Colors::DarkOliveGreen);
+            terrainObj.mesh->CopyConstants(&constants);
+
+            terrainObj.dirty = false;
+        }
     }
-    
 
-    XMMATRIX viewOrtTotal = XMLoadFloat4x4(&ViewOrtTotal);
-    XMMATRIX viewOrtTotalSide = XMLoadFloat4x4(&ViewOrtTotalSide);
-    XMMATRIX projOrtTotal = XMLoadFloat4x4(&ProjOrtTotal);
+    // as linhas tm cmeras prprias e fixas: a matriz combinada vai inteira
+    // no bloco do objeto e DrawLines usa a identidade como view-projection
+    if (linhas[0].dirty || linhas[1].dirty)
+    {
+        XMMATRIX viewOrtTotal = XMLoadFloat4x4(&ViewOrtTotal);
+        XMMATRIX viewOrtTotalSide = XMLoadFloat4x4(&ViewOrtTotalSide);
+        XMMATRIX projOrtTotal = XMLoadFloat4x4(&ProjOrtTotal);
 
-    bool first = true;
+        XMMATRIX worldL0 = XMLoadFloat4x4(&linhas[0].world);
+        XMMATRIX worldL1 = XMLoadFloat4x4(&linhas[1].world);
 
-    XMMATRIX worldL0 = XMLoadFloat4x4(&linhas[0].world);
-    XMMATRIX worldL1 = XMLoadFloat4x4(&linhas[1].world);
+        XMMATRIX WorldViewProjL0 = worldL0 * viewOrtTotal * projOrtTotal;
+        XMMATRIX WorldViewProjL1 = worldL1 * viewOrtTotalSide * projOrtTotal;
+        XMVECTOR color = DirectX::Colors::DimGray;
 
-    XMMATRIX WorldViewProjL0 = worldL0 * viewOrtTotal * projOrtTotal;
-    XMMATRIX WorldViewProjL1 = worldL1 * viewOrtTotalSide * projOrtTotal;
-    XMVECTOR color = DirectX::Colors::DimGray;
-    
-    ObjectConstants constants;
-    XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProjL0));
-    XMStoreFloat4(&constants.objColor, color);
-    linhas[0].mesh->CopyConstants(&constants, 0);
-    ObjectConstants constantsL1;
-    XMStoreFloat4x4(&constantsL1.WorldViewProj, XMMatrixTranspose(WorldViewProjL1));
-    XMStoreFloat4(&constantsL1.objColor, color);
-    linhas[1].mesh->CopyConstants(&constantsL1, 0);
+        ObjectConstants constants;
+        XMStoreFloat4x4(&constants.World, XMMatrixTranspose(XMLoadFloat4x4(&linhas[0].mesh->dequantize) * WorldViewProjL0));
+        XMStoreFloat4(&constants.objColor, color);
+        linhas[0].mesh->CopyConstants(&constants, linhas[0].cbIndex);
+        ObjectConstants constantsL1;
+        XMStoreFloat4x4(&constantsL1.World, XMMatrixTranspose(XMLoadFloat4x4(&linhas[1].mesh->dequantize) * WorldViewProjL1));
+        XMStoreFloat4(&constantsL1.objColor, color);
+        linhas[1].mesh->CopyConstants(&constantsL1, linhas[1].cbIndex);
+
+        linhas[0].dirty = false;
+        linhas[1].dirty = false;
+    }
 
+    profiler.Mark("terreno");
 
     graphics->SubmitCommands();
+
+    profiler.Mark("envio");
+}
+
+// ------------------------------------------------------------------------------
+
+void Multi::BindView(const ViewConstants& constants)
+{
+    // a view-projection  enviada uma vez por vista como constantes raiz;
+    // trocar a assinatura raiz invalidaria esses valores, por isso ela 
+    // ajustada aqui e no a cada objeto
+    graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
+    graphics->CommandList()->SetGraphicsRoot32BitConstants(1, 16, &constants.ViewProj, 0);
 }
 
 // ------------------------------------------------------------------------------
 
 void Multi::DrawObjects(int view) {
-    for (auto& obj : scene)
+    BindView(viewConstants[view]);
+
+    // apenas os objetos que passaram pelo descarte da vista
+    for (uint i : visibleObjects[view])
     {
+        const Object& obj = scene[i];
 
         // comandos de configurao do pipeline
         ID3D12DescriptorHeap* descriptorHeap = obj.mesh->ConstantBufferHeap();
         graphics->CommandList()->SetDescriptorHeaps(1, &descriptorHeap);
-        graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-        graphics->CommandList()->IASetVertexBuffers(0, 1, obj.mesh->VertexBufferView());
+        graphics->CommandList()->IASetVertexBuffers(0, obj.mesh->StreamCount(), obj.mesh->StreamViews());
         graphics->CommandList()->IASetIndexBuffer(obj.mesh->IndexBufferView());
         graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
         // ajusta o buffer constante associado ao vertex shader
-        graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(view));
+        graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(obj.cbIndex));
+
+        // desenha as sub-malhas do nvel de detalhe da vista
+        DrawSubMeshes(obj, view);
+    }
+
+}
 
-        // desenha objeto
+// ------------------------------------------------------------------------------
+
+void Multi::DrawSubMeshes(const Object& obj, int view)
+{
+    // a geometria  a do modelo; o objeto escolhe o nvel e os meshlets
+    const Geometry& geo = prefabs[obj.prefab].geo;
+
+    // sem nveis de detalhe, todas as sub-malhas so desenhadas
+    uint first = 0;
+    uint count = uint(geo.submeshes.size());
+
+    const vector<SubMesh>* parts = &geo.submeshes;
+
+    if (!geo.lods.empty())
+    {
+        const LodLevel& level = geo.lods[obj.lod[view]];
+        first = level.firstSubmesh;
+        count = level.submeshCount;
+    }
+
+    // nvel mais detalhado com meshlets: desenha as faixas que passaram pelo descarte
+    // (apenas objetos da cena passam por ele; as linhas desenham o nvel inteiro)
+    if (obj.lod[view] == 0 && !geo.meshletDraws.empty() && obj.node != NoNode)
+    {
+        parts = &obj.visible[view];
+        first = 0;
+        count = uint(parts->size());
+    }
+
+    for (uint i = first; i < first + count; ++i)
+    {
+        const SubMesh& part = (*parts)[i];
         graphics->CommandList()->DrawIndexedInstanced(
-            obj.submesh.indexCount, 1,
-            obj.submesh.startIndex,
-            obj.submesh.baseVertex,
+            part.indexCount, 1,
+            part.startIndex,
+            part.baseVertex,
             0);
     }
+}
+
 
+// ------------------------------------------------------------------------------
+
+void Multi::DrawTerrain(int view)
+{
+    if (!showTerrain)
+        return;
+
+    BindView(viewConstants[view]);
+
+    // comandos de configurao do pipeline
+    ID3D12DescriptorHeap* descriptorHeap = terrainObj.mesh->ConstantBufferHeap();
+    graphics->CommandList()->SetDescriptorHeaps(1, &descriptorHeap);
+    graphics->CommandList()->IASetVertexBuffers(0, terrainObj.mesh->StreamCount(), terrainObj.mesh->StreamViews());
+    graphics->CommandList()->IASetIndexBuffer(terrainObj.mesh->IndexBufferView());
+    graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    // ajusta o buffer constante associado ao vertex shader
+    graphics->CommandList()->SetGraphicsRootDescriptorTable(0, terrainObj.mesh->ConstantBufferHandle());
+
+    // cada pea usa a faixa de ndices do seu nvel a partir do seu primeiro vrtice
+    for (const SubMesh& part : terrainObj.visible[view])
+    {
+        graphics->CommandList()->DrawIndexedInstanced(
+            part.indexCount, 1,
+            part.startIndex,
+            part.baseVertex,
+            0);
+    }
 }
 
+// ------------------------------------------------------------------------------
 
 void Multi::DrawLines() {
+    BindView(ViewConstants());
+
     for (auto& obj : linhas)
     {
 
         // comandos de configurao do pipeline
         ID3D12DescriptorHeap* descriptorHeap = obj.mesh->ConstantBufferHeap();
         graphics->CommandList()->SetDescriptorHeaps(1, &descriptorHeap);
-        graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-        graphics->CommandList()->IASetVertexBuffers(0, 1, obj.mesh->VertexBufferView());
+        graphics->CommandList()->IASetVertexBuffers(0, obj.mesh->StreamCount(), obj.mesh->StreamViews());
         graphics->CommandList()->IASetIndexBuffer(obj.mesh->IndexBufferView());
         graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
         // ajusta o buffer constante associado ao vertex shader
-        graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(0));
+        graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(obj.cbIndex));
 
-        // desenha objeto
-        graphics->CommandList()->DrawIndexedInstanced(
-            obj.submesh.indexCount, 1,
-            obj.submesh.startIndex,
-            obj.submesh.baseVertex,
-            0);
+        // desenha as sub-malhas do objeto
+        DrawSubMeshes(obj, 0);
     }
 }
 
@@ -969,6 +1697,8 @@ void Multi::Draw()
                     DrawObjects(i);
                     break;
             }
+
+            DrawTerrain(i);
             
             
         }
@@ -977,29 +1707,44 @@ void Multi::Draw()
 
     // desenha objetos da cena
     if (!quadView) {
-        for (auto& obj : scene)
+        BindView(viewConstants[0]);
+
+        for (uint i : visibleObjects[0])
         {
+            const Object& obj = scene[i];
+
             // comandos de configurao do pipeline
             ID3D12DescriptorHeap* descriptorHeap = obj.mesh->ConstantBufferHeap();
             graphics->CommandList()->SetDescriptorHeaps(1, &descriptorHeap);
-            graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
-            graphics->CommandList()->IASetVertexBuffers(0, 1, obj.mesh->VertexBufferView());
+            graphics->CommandList()->IASetVertexBuffers(0, obj.mesh->StreamCount(), obj.mesh->StreamViews());
             graphics->CommandList()->IASetIndexBuffer(obj.mesh->IndexBufferView());
             graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
             // ajusta o buffer constante associado ao vertex shader
-            graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(0));
-
-            // desenha objeto
-            graphics->CommandList()->DrawIndexedInstanced(
-                obj.submesh.indexCount, 1,
-                obj.submesh.startIndex,
-                obj.submesh.baseVertex,
-                0);
+            graphics->CommandList()->SetGraphicsRootDescriptorTable(0, obj.mesh->ConstantBufferHandle(obj.cbIndex));
+
+            // desenha as sub-malhas do nvel de detalhe da vista
+            DrawSubMeshes(obj, 0);
         }
+
+        DrawTerrain(0);
     }
+
+    profiler.Mark("desenho");
+
     // apresenta o backbuffer na tela
     graphics->Present();    
+
+    profiler.Mark("apresentacao");
+    profiler.End();
+
+    // relatrio a cada 120 quadros; fora do modo de estresse os valores so descartados
+    if (profiler.Frames() == 120)
+    {
+        std::string report = profiler.Report();
+        if (stress)
+            OutputDebugString(("Estresse com " + std::to_string(scene.Size()) + " objetos, " + report).c_str());
+    }
 }
 
 // ------------------------------------------------------------------------------
@@ -1009,8 +1754,11 @@ void Multi::Finalize()
     rootSignature->Release();
     pipelineState->Release();
 
-    for (auto& obj : scene)
-        delete obj.mesh;
+    for (Prefab& prefab : prefabs)
+        delete prefab.mesh;
+
+    delete terrainObj.mesh;
+    delete terrain;
 }
 
 
@@ -1020,7 +1768,7 @@ void Multi::Finalize()
 
 void Multi::BuildRootSignature()
 {
-    // cria uma nica tabela de descritores de CBVs
+    // tabela de descritores com o buffer constante do objeto
     D3D12_DESCRIPTOR_RANGE cbvTable = {};
     cbvTable.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV;
     cbvTable.NumDescriptors = 1;
@@ -1028,16 +1776,23 @@ void Multi::BuildRootSignature()
     cbvTable.RegisterSpace = 0;
     cbvTable.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
-    // define parmetro raiz com uma tabela
-    D3D12_ROOT_PARAMETER rootParameters[1];
+    // define parmetros raiz: a tabela do objeto (b0) e a
+    // view-projection da vista como 16 constantes raiz (b1)
+    D3D12_ROOT_PARAMETER rootParameters[2];
     rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
     rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
     rootParameters[0].DescriptorTable.NumDescriptorRanges = 1;
     rootParameters[0].DescriptorTable.pDescriptorRanges = &cbvTable;
 
+    rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+    rootParameters[1].Constants.ShaderRegister = 1;
+    rootParameters[1].Constants.RegisterSpace = 0;
+    rootParameters[1].Constants.Num32BitValues = sizeof(ViewConstants) / 4;
+
     // uma assinatura raiz  um vetor de parmetros raiz
     D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {};
-    rootSigDesc.NumParameters = 1;
+    rootSigDesc.NumParameters = 2;
     rootSigDesc.pParameters = rootParameters;
     rootSigDesc.NumStaticSamplers = 0;
     rootSigDesc.pStaticSamplers = nullptr;
@@ -1058,8 +1813,8 @@ void Multi::BuildRootSignature()
         OutputDebugString((char*)error->GetBufferPointer());
     }
 
-    // cria uma assinatura raiz com um nico slot que aponta para  
-    // uma faixa de descritores consistindo de um nico buffer constante
+    // cria uma assinatura raiz com um slot que aponta para o buffer
+    // constante do objeto e outro com as constantes da vista
     ThrowIfFailed(graphics->Device()->CreateRootSignature(
         0,
         serializedRootSig->GetBufferPointer(),
@@ -1075,11 +1830,8 @@ void Multi::BuildPipelineState()
     // --- Input Layout ---
     // --------------------
     
-    D3D12_INPUT_ELEMENT_DESC inputLayout[2] =
-    {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-    };
+    // atributos gerados a partir do tipo de vrtice usado pelos vertex buffers
+    auto inputLayout = InputLayout<SceneVertex>(splitPositions);
 
     // --------------------
     // ----- Shaders ------
@@ -1155,7 +1907,7 @@ void Multi::BuildPipelineState()
     pso.SampleMask = UINT_MAX;
     pso.RasterizerState = rasterizer;
     pso.DepthStencilState = depthStencil;
-    pso.InputLayout = { inputLayout, 2 };
+    pso.InputLayout = { inputLayout.data(), uint(inputLayout.size()) };
     pso.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
     pso.NumRenderTargets = 1;
     pso.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
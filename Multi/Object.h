@@ -14,20 +14,31 @@
 
 #include "Types.h"
 #include "Mesh.h"
+#include "SceneGraph.h"
 #include <DirectXMath.h>
 using DirectX::XMFLOAT4X4;
 
+const uint NoPrefab = uint(-1);     // objeto sem modelo: a malha pertence ao objeto (terreno)
+
 struct Object
 {
-	XMFLOAT4X4 world = {            // matriz de mundo
+	XMFLOAT4X4 world = {            // matriz de mundo (nos objetos da cena, apenas a inicial:
+	                                // a atual fica no TransformStore)
 		1.0f, 0.0f, 0.0f, 0.0f,
 		0.0f, 1.0f, 0.0f, 0.0f,
 		0.0f, 0.0f, 1.0f, 0.0f,
 		0.0f, 0.0f, 0.0f, 1.0f };
 
-	uint cbIndex = -1;			    // ndice para o constant buffer
+	uint cbIndex = 0;			    // ndice para o constant buffer
 	Mesh * mesh = nullptr;			// malha de vrtices
-	SubMesh submesh {};	            // informaes da sub-malha
+	uint prefab = NoPrefab;			// modelo com a malha e a geometria compartilhada
+	                                // (sub-malhas, nveis de detalhe e meshlets)
+	uint lod[4] = { 0, 0, 0, 0 };   // nvel escolhido em cada vista
+	vector<SubMesh> visible[4];		// meshlets visveis em cada vista
+
+	Bounds worldBounds;		                // volumes envolventes no espao do mundo
+	bool dirty = true;						// mundo ou cor mudaram: refazer constantes e dados derivados
+	uint node = NoNode;						// n na hierarquia de transformaes
 };
 
 #endif
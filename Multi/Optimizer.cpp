@@ -0,0 +1,585 @@
+/**********************************************************************************
+// Optimizer (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Reordena ndices de malhas trianguladas para aproveitar melhor
+//              o cache de vrtices transformados da GPU e reduzir o overdraw,
+//              e reordena vrtices para acessos sequenciais  memria. As
+//              funes trabalham diretamente sobre vetores de ndices e 
+//              servem para qualquer formato de vrtice
+//
+**********************************************************************************/
+
+#include "Optimizer.h"
+#include "Arena.h"
+#include <climits>
+#include <cstddef>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+// Funes auxiliares
+
+// tringulos adjacentes a cada vrtice em formato compacto:
+// os tringulos do vrtice v esto em list[offsets[v]] at list[offsets[v+1]-1]
+struct Adjacency
+{
+    std::pmr::vector<uint> offsets;
+    std::pmr::vector<uint> list;
+
+    Adjacency(const uint* indices, uint indexCount, uint vertexCount,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : offsets(resource), list(resource)
+    {
+        offsets.assign(size_t(vertexCount) + 1, 0);
+        list.resize(indexCount);
+
+        // conta tringulos por vrtice
+        for (uint i = 0; i < indexCount; ++i)
+            ++offsets[size_t(indices[i]) + 1];
+
+        // soma de prefixo
+        for (uint v = 0; v < vertexCount; ++v)
+            offsets[size_t(v) + 1] += offsets[v];
+
+        // preenche as listas
+        std::pmr::vector<uint> cursor(offsets.begin(), offsets.end() - 1, resource);
+        for (uint i = 0; i < indexCount; ++i)
+            list[cursor[indices[i]]++] = i / 3;
+    }
+
+    uint Count(uint v) const
+    { return offsets[size_t(v) + 1] - offsets[v]; }
+};
+
+// -------------------------------------------------------------------------------
+
+// acesso a posies intercaladas com qualquer formato de vrtice
+struct PositionStream
+{
+    const unsigned char* data;
+    uint stride;
+
+    PositionStream(const float* positions, uint vertexStride)
+        : data(reinterpret_cast<const unsigned char*>(positions)), stride(vertexStride) {}
+
+    const float* operator[](uint v) const
+    { return reinterpret_cast<const float*>(data + size_t(v) * stride); }
+};
+
+// -------------------------------------------------------------------------------
+
+// cache FIFO simulado: retorna nmero de falhas ao processar um tringulo
+struct FifoCache
+{
+    vector<uint> timestamp;
+    uint time;
+    uint size;
+
+    FifoCache(uint vertexCount, uint cacheSize)
+        : timestamp(vertexCount, 0), time(cacheSize + 1), size(cacheSize) {}
+
+    void Clear()
+    { time += size + 1; }
+
+    uint Triangle(const uint* tri)
+    {
+        uint misses = 0;
+        for (uint c = 0; c < 3; ++c)
+        {
+            if (time - timestamp[tri[c]] > size)
+            {
+                timestamp[tri[c]] = time++;
+                ++misses;
+            }
+        }
+        return misses;
+    }
+};
+
+// -------------------------------------------------------------------------------
+
+float ComputeACMR(const uint* indices, uint indexCount, uint vertexCount, uint cacheSize)
+{
+    if (indexCount < 3)
+        return 0.0f;
+
+    // cache FIFO: um vrtice est no cache se foi inserido
+    // h menos de cacheSize inseres
+    vector<uint> timestamp(vertexCount, 0);
+    uint time = cacheSize + 1;
+    uint misses = 0;
+
+    for (uint i = 0; i < indexCount; ++i)
+    {
+        uint v = indices[i];
+
+        if (time - timestamp[v] > cacheSize)
+        {
+            timestamp[v] = time++;
+            ++misses;
+        }
+    }
+
+    return float(misses) / (indexCount / 3);
+}
+
+// -------------------------------------------------------------------------------
+
+void OptimizeVertexCache(uint* destination, const uint* indices, uint indexCount, uint vertexCount, uint cacheSize)
+{
+    uint triCount = indexCount / 3;
+    if (triCount == 0)
+        return;
+
+    // chamada uma vez por meshlet: os temporrios ficam na arena de rascunho
+    ArenaScope scope(ScratchArena());
+    std::pmr::memory_resource* scratch = &ScratchArena();
+
+    // destino pode coincidir com a entrada
+    std::pmr::vector<uint> input(indices, indices + size_t(triCount) * 3, scratch);
+
+    Adjacency adjacency(input.data(), triCount * 3, vertexCount, scratch);
+
+    // tringulos ainda no emitidos que usam cada vrtice
+    std::pmr::vector<uint> live(vertexCount, scratch);
+    for (uint v = 0; v < vertexCount; ++v)
+        live[v] = adjacency.Count(v);
+
+    std::pmr::vector<uint> timestamp(vertexCount, 0, scratch);  // momento da entrada no cache
+    std::pmr::vector<bool> emitted(triCount, false, scratch);   // tringulos j emitidos
+    std::pmr::vector<uint> deadEnd(scratch);                    // pilha de vrtices recentes
+    std::pmr::vector<uint> candidates(scratch);                 // vizinhos do ltimo leque
+    deadEnd.reserve(indexCount);
+    candidates.reserve(64);
+
+    uint time = cacheSize + 1;                      // relgio do cache simulado
+    uint cursor = 0;                                // varredura sequencial de vrtices
+    uint output = 0;                                // ndices escritos no destino
+
+    // escolhe um vrtice com tringulos pendentes quando a vizinhana se esgota:
+    // primeiro os vrtices recentes da pilha, depois a varredura na ordem original
+    auto SkipDeadEnd = [&]() -> uint
+    {
+        while (!deadEnd.empty())
+        {
+            uint d = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[d] > 0)
+                return d;
+        }
+
+        while (cursor < vertexCount)
+        {
+            if (live[cursor] > 0)
+                return cursor;
+            ++cursor;
+        }
+
+        return UINT_MAX;
+    };
+
+    uint fan = SkipDeadEnd();
+
+    while (fan != UINT_MAX)
+    {
+        candidates.clear();
+
+        // emite todos os tringulos pendentes em leque ao redor do vrtice atual
+        for (uint k = adjacency.offsets[fan]; k < adjacency.offsets[size_t(fan) + 1]; ++k)
+        {
+            uint t = adjacency.list[k];
+            if (emitted[t])
+                continue;
+
+            for (uint c = 0; c < 3; ++c)
+            {
+                uint v = input[size_t(t) * 3 + c];
+                destination[output++] = v;
+
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+
+                // vrtice fora do cache  transformado novamente
+                if (time - timestamp[v] > cacheSize)
+                    timestamp[v] = time++;
+            }
+
+            emitted[t] = true;
+        }
+
+        // prximo leque: vizinho que continuar no cache aps emitir
+        // seus tringulos restantes, preferindo o mais antigo deles
+        uint next = UINT_MAX;
+        int best = -1;
+
+        for (uint v : candidates)
+        {
+            if (live[v] == 0)
+                continue;
+
+            int priority = 0;
+            if (time - timestamp[v] + 2 * live[v] <= cacheSize)
+                priority = int(time - timestamp[v]);
+
+            if (priority > best)
+            {
+                best = priority;
+                next = v;
+            }
+        }
+
+        fan = (next != UINT_MAX ? next : SkipDeadEnd());
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void OptimizeOverdraw(uint* destination, const uint* indices, uint indexCount, const float* positions, uint vertexCount, uint vertexStride, float threshold)
+{
+    uint triCount = indexCount / 3;
+    if (triCount == 0)
+        return;
+
+    vector<uint> input(indices, indices + size_t(triCount) * 3);
+    PositionStream pos(positions, vertexStride);
+
+    // -------------------------------------------------------
+    // Blocos rgidos: comeam onde o cache perde os 3 vrtices
+    // do tringulo (incio de um novo leque no Tipsify)
+    // -------------------------------------------------------
+
+    FifoCache cache(vertexCount, VertexCacheSize);
+    vector<uint> hard;
+
+    for (uint t = 0; t < triCount; ++t)
+        if (cache.Triangle(&input[size_t(t) * 3]) == 3)
+            hard.push_back(t);
+
+    if (hard.empty() || hard[0] != 0)
+        hard.insert(hard.begin(), 0);
+    hard.push_back(triCount);
+
+    // ---------------------------------------------------------
+    // Blocos flexveis: um bloco rgido  quebrado sempre que o
+    // ACMR acumulado j est prximo do ACMR do bloco inteiro
+    // ---------------------------------------------------------
+
+    vector<uint> clusters;
+
+    for (size_t h = 0; h + 1 < hard.size(); ++h)
+    {
+        uint start = hard[h];
+        uint end = hard[h + 1];
+
+        // ACMR do bloco rgido processado sozinho
+        cache.Clear();
+        uint misses = 0;
+        for (uint t = start; t < end; ++t)
+            misses += cache.Triangle(&input[size_t(t) * 3]);
+
+        float limit = threshold * float(misses) / float(end - start);
+
+        // reprocessa marcando novos blocos nos pontos de corte
+        cache.Clear();
+        clusters.push_back(start);
+        uint clusterStart = start;
+        misses = 0;
+
+        for (uint t = start; t < end; ++t)
+        {
+            misses += cache.Triangle(&input[size_t(t) * 3]);
+
+            if (t + 1 < end && float(misses) / float(t + 1 - clusterStart) <= limit)
+            {
+                clusters.push_back(t + 1);
+                clusterStart = t + 1;
+                misses = 0;
+                cache.Clear();
+            }
+        }
+    }
+
+    clusters.push_back(triCount);
+    uint clusterCount = uint(clusters.size() - 1);
+
+    // ------------------------------------------------------------
+    // Mtrica de ocluso: distncia do centride do bloco ao centro
+    // da malha projetada na normal mdia do bloco; blocos externos
+    // e voltados para fora tendem a ocultar os demais
+    // ------------------------------------------------------------
+
+    float meshCenter[3] = { 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+
+    vector<float> clusterData(size_t(clusterCount) * 6, 0.0f);     // centride e normal
+
+    for (uint k = 0; k < clusterCount; ++k)
+    {
+        float* centroid = &clusterData[size_t(k) * 6];
+        float* normal = centroid + 3;
+        float area = 0.0f;
+
+        for (uint t = clusters[k]; t < clusters[size_t(k) + 1]; ++t)
+        {
+            const float* p0 = pos[input[size_t(t) * 3 + 0]];
+            const float* p1 = pos[input[size_t(t) * 3 + 1]];
+            const float* p2 = pos[input[size_t(t) * 3 + 2]];
+
+            float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+            float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+            float n[3] =
+            {
+                e1[1] * e2[2] - e1[2] * e2[1],
+                e1[2] * e2[0] - e1[0] * e2[2],
+                e1[0] * e2[1] - e1[1] * e2[0]
+            };
+
+            // comprimento da normal  o dobro da rea do tringulo
+            float a = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+            for (uint i = 0; i < 3; ++i)
+            {
+                centroid[i] += (p0[i] + p1[i] + p2[i]) * (a / 3.0f);
+                normal[i] += n[i];
+                meshCenter[i] += (p0[i] + p1[i] + p2[i]) * (a / 3.0f);
+            }
+
+            area += a;
+        }
+
+        meshArea += area;
+
+        float inv = (area > 0.0f ? 1.0f / area : 0.0f);
+        float len = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        float invLen = (len > 0.0f ? 1.0f / len : 0.0f);
+
+        for (uint i = 0; i < 3; ++i)
+        {
+            centroid[i] *= inv;
+            normal[i] *= invLen;
+        }
+    }
+
+    float inv = (meshArea > 0.0f ? 1.0f / meshArea : 0.0f);
+    for (uint i = 0; i < 3; ++i)
+        meshCenter[i] *= inv;
+
+    vector<float> sortKey(clusterCount);
+    for (uint k = 0; k < clusterCount; ++k)
+    {
+        const float* centroid = &clusterData[size_t(k) * 6];
+        const float* normal = centroid + 3;
+
+        sortKey[k] =
+            (centroid[0] - meshCenter[0]) * normal[0] +
+            (centroid[1] - meshCenter[1]) * normal[1] +
+            (centroid[2] - meshCenter[2]) * normal[2];
+    }
+
+    // ---------------------------------------------------------
+    // Ordena blocos pela mtrica (maior primeiro) e copia blocos
+    // ---------------------------------------------------------
+
+    vector<uint> order(clusterCount);
+    for (uint k = 0; k < clusterCount; ++k)
+        order[k] = k;
+
+    std::stable_sort(order.begin(), order.end(),
+        [&](uint a, uint b) { return sortKey[a] > sortKey[b]; });
+
+    uint output = 0;
+    for (uint k : order)
+    {
+        for (uint t = clusters[k]; t < clusters[size_t(k) + 1]; ++t)
+        {
+            destination[output++] = input[size_t(t) * 3 + 0];
+            destination[output++] = input[size_t(t) * 3 + 1];
+            destination[output++] = input[size_t(t) * 3 + 2];
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+float ComputeOverdraw(const uint* indices, uint indexCount, const float* positions, uint vertexCount, uint vertexStride)
+{
+    const int GridSize = 256;                   // resoluo do alvo simulado
+
+    uint triCount = indexCount / 3;
+    if (triCount == 0 || vertexCount == 0)
+        return 0.0f;
+
+    PositionStream pos(positions, vertexStride);
+
+    // caixa envolvente para normalizar as posies no alvo
+    float minP[3] = { pos[0][0], pos[0][1], pos[0][2] };
+    float maxP[3] = { pos[0][0], pos[0][1], pos[0][2] };
+
+    for (uint v = 1; v < vertexCount; ++v)
+    {
+        for (uint i = 0; i < 3; ++i)
+        {
+            minP[i] = std::min(minP[i], pos[v][i]);
+            maxP[i] = std::max(maxP[i], pos[v][i]);
+        }
+    }
+
+    float extent = std::max(maxP[0] - minP[0], std::max(maxP[1] - minP[1], maxP[2] - minP[2]));
+    float scale = (extent > 0.0f ? (GridSize - 1) / extent : 0.0f);
+
+    vector<float> depth(size_t(GridSize) * GridSize);
+    ullong shaded = 0;
+    ullong covered = 0;
+
+    // olha ao longo dos eixos x, y e z nos dois sentidos
+    for (uint axis = 0; axis < 3; ++axis)
+    {
+        uint u = (axis + 1) % 3;
+        uint w = (axis + 2) % 3;
+
+        for (int dir = -1; dir <= 1; dir += 2)
+        {
+            std::fill(depth.begin(), depth.end(), FLT_MAX);
+
+            for (uint t = 0; t < triCount; ++t)
+            {
+                const float* p[3] = 
+                { 
+                    pos[indices[size_t(t) * 3 + 0]], 
+                    pos[indices[size_t(t) * 3 + 1]], 
+                    pos[indices[size_t(t) * 3 + 2]] 
+                };
+
+                // descarta faces traseiras: normal (ordem horria) aponta para longe da cmera
+                float e1u = p[1][u] - p[0][u], e1w = p[1][w] - p[0][w];
+                float e2u = p[2][u] - p[0][u], e2w = p[2][w] - p[0][w];
+                float nAxis = e1u * e2w - e1w * e2u;
+                if (nAxis * dir >= 0.0f)
+                    continue;
+
+                // coordenadas no alvo e profundidade ao longo da direo de viso
+                float x[3], y[3], z[3];
+                for (uint i = 0; i < 3; ++i)
+                {
+                    x[i] = (p[i][u] - minP[u]) * scale;
+                    y[i] = (p[i][w] - minP[w]) * scale;
+                    z[i] = p[i][axis] * dir;
+                }
+
+                float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+                if (area == 0.0f)
+                    continue;
+
+                float invArea = 1.0f / area;
+
+                int x0 = std::max(0, int(floorf(std::min(x[0], std::min(x[1], x[2])))));
+                int x1 = std::min(GridSize - 1, int(ceilf(std::max(x[0], std::max(x[1], x[2])))));
+                int y0 = std::max(0, int(floorf(std::min(y[0], std::min(y[1], y[2])))));
+                int y1 = std::min(GridSize - 1, int(ceilf(std::max(y[0], std::max(y[1], y[2])))));
+
+                // rasteriza com funes de aresta avaliadas no centro dos pixels
+                for (int py = y0; py <= y1; ++py)
+                {
+                    for (int px = x0; px <= x1; ++px)
+                    {
+                        float cx = px + 0.5f;
+                        float cy = py + 0.5f;
+
+                        float b0 = ((x[2] - x[1]) * (cy - y[1]) - (y[2] - y[1]) * (cx - x[1])) * invArea;
+                        float b1 = ((x[0] - x[2]) * (cy - y[2]) - (y[0] - y[2]) * (cx - x[2])) * invArea;
+                        float b2 = 1.0f - b0 - b1;
+
+                        if (b0 < 0.0f || b1 < 0.0f || b2 < 0.0f)
+                            continue;
+
+                        float d = b0 * z[0] + b1 * z[1] + b2 * z[2];
+                        float& stored = depth[size_t(py) * GridSize + px];
+
+                        // teste de profundidade LESS como no pipeline
+                        if (d < stored)
+                        {
+                            if (stored == FLT_MAX)
+                                ++covered;
+                            stored = d;
+                            ++shaded;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return (covered ? float(double(shaded) / double(covered)) : 0.0f);
+}
+
+// -------------------------------------------------------------------------------
+
+uint GenerateFetchRemap(uint* remap, const uint* indices, uint indexCount, uint vertexCount)
+{
+    for (uint v = 0; v < vertexCount; ++v)
+        remap[v] = UINT_MAX;
+
+    // cada vrtice recebe o prximo nmero livre no seu primeiro uso
+    uint next = 0;
+    for (uint i = 0; i < indexCount; ++i)
+    {
+        uint v = indices[i];
+        if (remap[v] == UINT_MAX)
+            remap[v] = next++;
+    }
+
+    return next;
+}
+
+// -------------------------------------------------------------------------------
+
+void RemapIndexBuffer(uint* destination, const uint* indices, uint indexCount, const uint* remap)
+{
+    for (uint i = 0; i < indexCount; ++i)
+        destination[i] = remap[indices[i]];
+}
+
+// -------------------------------------------------------------------------------
+
+void RemapVertexBuffer(void* destination, const void* vertices, uint vertexCount, uint vertexStride, const uint* remap)
+{
+    const unsigned char* src = static_cast<const unsigned char*>(vertices);
+    vector<unsigned char> copy;
+
+    // destino coincide com a entrada: trabalha sobre uma cpia
+    if (destination == vertices)
+    {
+        copy.assign(src, src + size_t(vertexCount) * vertexStride);
+        src = copy.data();
+    }
+
+    unsigned char* dst = static_cast<unsigned char*>(destination);
+
+    for (uint v = 0; v < vertexCount; ++v)
+        if (remap[v] != UINT_MAX)
+            memcpy(dst + size_t(remap[v]) * vertexStride, src + size_t(v) * vertexStride, vertexStride);
+}
+
+// -------------------------------------------------------------------------------
+
+uint OptimizeVertexFetch(void* destination, uint* indices, uint indexCount, const void* vertices, uint vertexCount, uint vertexStride)
+{
+    vector<uint> remap(vertexCount);
+    uint used = GenerateFetchRemap(remap.data(), indices, indexCount, vertexCount);
+
+    RemapIndexBuffer(indices, indices, indexCount, remap.data());
+    RemapVertexBuffer(destination, vertices, vertexCount, vertexStride, remap.data());
+
+    return used;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,104 @@
+/**********************************************************************************
+// Optimizer (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Reordena ndices de malhas trianguladas para aproveitar melhor
+//              o cache de vrtices transformados da GPU e reduzir o overdraw,
+//              e reordena vrtices para acessos sequenciais  memria. As
+//              funes trabalham diretamente sobre vetores de ndices e 
+//              servem para qualquer formato de vrtice
+//
+**********************************************************************************/
+
+#ifndef DXUT_OPTIMIZER_H_
+#define DXUT_OPTIMIZER_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+
+// -------------------------------------------------------------------------------
+
+// tamanho do cache de vrtices transformados usado por padro
+const uint VertexCacheSize = 16;
+
+// -------------------------------------------------------------------------------
+
+// razo mdia de falhas no cache (ACMR): vrtices transformados por tringulo,
+// simulando um cache FIFO com o tamanho indicado (ideal ~0.5, pior caso 3.0)
+float ComputeACMR(
+    const uint* indices,                    // ndices da malha (lista de tringulos)
+    uint indexCount,                        // nmero de ndices
+    uint vertexCount,                       // nmero de vrtices
+    uint cacheSize = VertexCacheSize);      // tamanho do cache simulado
+
+// reordena os tringulos com o algoritmo Tipsify (Sander, Nehab e Barczak, 2007);
+// destination pode ser o prprio vetor de entrada
+void OptimizeVertexCache(
+    uint* destination,                      // ndices reordenados
+    const uint* indices,                    // ndices da malha (lista de tringulos)
+    uint indexCount,                        // nmero de ndices
+    uint vertexCount,                       // nmero de vrtices
+    uint cacheSize = VertexCacheSize);      // tamanho do cache alvo
+
+// agrupa tringulos em blocos que preservam a eficincia do cache e ordena os blocos
+// por uma mtrica de ocluso independente de ponto de vista (blocos na face externa
+// e voltados para fora primeiro); deve ser aplicada aps OptimizeVertexCache
+void OptimizeOverdraw(
+    uint* destination,                      // ndices reordenados
+    const uint* indices,                    // ndices otimizados para o cache
+    uint indexCount,                        // nmero de ndices
+    const float* positions,                 // posio (x,y,z) do primeiro vrtice
+    uint vertexCount,                       // nmero de vrtices
+    uint vertexStride,                      // distncia em bytes entre posies
+    float threshold = 1.05f);               // perda mxima de ACMR aceita (1.05 = 5%)
+
+// estima o overdraw na CPU rasterizando a malha em 6 direes axiais com teste de
+// profundidade e descarte de faces traseiras: pixels sombreados / pixels cobertos
+float ComputeOverdraw(
+    const uint* indices,                    // ndices da malha (lista de tringulos)
+    uint indexCount,                        // nmero de ndices
+    const float* positions,                 // posio (x,y,z) do primeiro vrtice
+    uint vertexCount,                       // nmero de vrtices
+    uint vertexStride);                     // distncia em bytes entre posies
+
+// tabela de renumerao de vrtices na ordem do primeiro uso pelos ndices;
+// vrtices no referenciados recebem ~0u; retorna o nmero de vrtices usados
+uint GenerateFetchRemap(
+    uint* remap,                            // novo ndice de cada vrtice (vertexCount)
+    const uint* indices,                    // ndices da malha
+    uint indexCount,                        // nmero de ndices
+    uint vertexCount);                      // nmero de vrtices
+
+// aplica a renumerao aos ndices (destination pode ser o prprio vetor)
+void RemapIndexBuffer(
+    uint* destination,                      // ndices renumerados
+    const uint* indices,                    // ndices originais
+    uint indexCount,                        // nmero de ndices
+    const uint* remap);                     // tabela de renumerao
+
+// aplica a renumerao a um vetor de vrtices de qualquer formato; vrtices
+// no referenciados so descartados (destination pode ser o prprio vetor)
+void RemapVertexBuffer(
+    void* destination,                      // vrtices renumerados
+    const void* vertices,                   // vrtices originais
+    uint vertexCount,                       // nmero de vrtices originais
+    uint vertexStride,                      // tamanho em bytes de um vrtice
+    const uint* remap);                     // tabela de renumerao
+
+// reordena vrtices na ordem do primeiro uso pelos ndices, ajusta os ndices
+// e descarta vrtices no referenciados; retorna o novo nmero de vrtices
+uint OptimizeVertexFetch(
+    void* destination,                      // vrtices reordenados (pode ser a entrada)
+    uint* indices,                          // ndices, ajustados no prprio vetor
+    uint indexCount,                        // nmero de ndices
+    const void* vertices,                   // vrtices originais
+    uint vertexCount,                       // nmero de vrtices originais
+    uint vertexStride);                     // tamanho em bytes de um vrtice
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,128 @@
+/**********************************************************************************
+// Parallel (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Divide laos longos em faixas contguas executadas em paralelo
+//              por um grupo fixo de threads, criado no primeiro uso. Cada faixa 
+//               processada por uma nica thread, de forma que dados escritos 
+//              por faixa no precisam de sincronizao
+//
+**********************************************************************************/
+
+#include "Parallel.h"
+
+// -------------------------------------------------------------------------------
+
+WorkerPool::WorkerPool() 
+    : busy(false), next(0), generation(0), pending(0), quit(false),
+      task(nullptr), context(nullptr), count(0), step(0), chunks(0)
+{
+    // a thread chamadora completa o nmero de threads disponveis
+    uint n = ParallelThreads();
+    threads.reserve(n - 1);
+
+    for (uint i = 1; i < n; ++i)
+        threads.emplace_back(&WorkerPool::Loop, this);
+}
+
+// -------------------------------------------------------------------------------
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+
+    wake.notify_all();
+
+    for (std::thread& t : threads)
+        t.join();
+}
+
+// -------------------------------------------------------------------------------
+
+WorkerPool& WorkerPool::Instance()
+{
+    static WorkerPool pool;
+    return pool;
+}
+
+// -------------------------------------------------------------------------------
+
+void WorkerPool::Loop()
+{
+    uint seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (;;)
+    {
+        wake.wait(lock, [&] { return quit || generation != seen; });
+        if (quit)
+            return;
+
+        seen = generation;
+
+        lock.unlock();
+        RunChunks();
+        lock.lock();
+
+        // a ltima thread a terminar libera a chamadora
+        if (--pending == 0)
+            done.notify_one();
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void WorkerPool::RunChunks()
+{
+    // as faixas so distribudas a quem chegar primeiro
+    for (uint c = next++; c < chunks; c = next++)
+    {
+        uint begin = c * step;
+        uint end = (begin + step < count ? begin + step : count);
+        if (begin < end)
+            task(context, begin, end);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+bool WorkerPool::Run(Task func, void* data, uint size, uint stride, uint parts)
+{
+    // chamada aninhada ou de outra thread durante um trabalho
+    if (busy.exchange(true))
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = func;
+        context = data;
+        count = size;
+        step = stride;
+        chunks = parts;
+        next = 0;
+        pending = uint(threads.size());
+        ++generation;
+    }
+
+    wake.notify_all();
+
+    // a chamadora tambm processa faixas e depois espera pelas threads,
+    // que ainda podem estar lendo o trabalho corrente
+    RunChunks();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return pending == 0; });
+    }
+
+    busy = false;
+    return true;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,115 @@
+/**********************************************************************************
+// Parallel (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Divide laos longos em faixas contguas executadas em paralelo
+//              por um grupo fixo de threads, criado no primeiro uso. Cada faixa 
+//               processada por uma nica thread, de forma que dados escritos 
+//              por faixa no precisam de sincronizao
+//
+**********************************************************************************/
+
+#ifndef DXUT_PARALLEL_H_
+#define DXUT_PARALLEL_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// -------------------------------------------------------------------------------
+
+// nmero de threads de trabalho disponveis
+inline uint ParallelThreads()
+{
+    uint n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+}
+
+// -------------------------------------------------------------------------------
+
+// threads criadas uma nica vez e reaproveitadas por todos os laos paralelos:
+// um lao por quadro no paga a criao e a destruio de threads
+class WorkerPool
+{
+public:
+    using Task = void (*)(void* context, uint begin, uint end);
+
+private:
+    std::vector<std::thread> threads;       // threads de trabalho (a chamadora tambm trabalha)
+    std::mutex mutex;                       // protege a troca de trabalho
+    std::condition_variable wake;           // acorda as threads para um novo trabalho
+    std::condition_variable done;           // avisa a chamadora que as threads terminaram
+    std::atomic<bool> busy;                 // trabalho em andamento
+    std::atomic<uint> next;                 // prxima faixa a ser processada
+    uint generation;                        // identifica o trabalho corrente
+    uint pending;                           // threads que ainda no terminaram o trabalho
+    bool quit;                              // encerra as threads
+
+    Task task;                              // funo que processa uma faixa
+    void* context;                          // dados da funo
+    uint count;                             // elementos do lao
+    uint step;                              // elementos por faixa
+    uint chunks;                            // nmero de faixas
+
+    WorkerPool();                           // construtor
+    ~WorkerPool();                          // destrutor
+
+    void Loop();                            // espera e executa trabalhos
+    void RunChunks();                       // processa faixas at acabarem
+
+public:
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    static WorkerPool& Instance();          // grupo compartilhado pela aplicao
+
+    // divide [0, count) em chunks faixas de step elementos; retorna false sem 
+    // executar nada se o grupo j estiver ocupado (lao paralelo aninhado)
+    bool Run(Task task, void* context, uint count, uint step, uint chunks);
+};
+
+// -------------------------------------------------------------------------------
+
+// executa func(inicio, fim) sobre faixas de [0, count) com pelo menos grain elementos;
+// a thread chamadora processa faixas junto com o grupo e espera pelas demais
+template<class Func>
+void ParallelFor(uint count, uint grain, Func func)
+{
+    if (count == 0)
+        return;
+
+    // nmero de faixas limitado pelo nmero de threads
+    uint chunks = (count + grain - 1) / (grain ? grain : 1);
+    uint threads = ParallelThreads();
+    chunks = (chunks < threads ? chunks : threads);
+
+    // laos curtos no compensam acordar as threads
+    if (chunks <= 1)
+    {
+        func(0u, count);
+        return;
+    }
+
+    uint step = (count + chunks - 1) / chunks;
+
+    auto task = [](void* context, uint begin, uint end)
+    {
+        (*static_cast<Func*>(context))(begin, end);
+    };
+
+    // laos aninhados executam em srie na thread que j est no grupo
+    if (!WorkerPool::Instance().Run(task, &func, count, step, chunks))
+        func(0u, count);
+}
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,91 @@
+/**********************************************************************************
+// Profiler (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Mede o tempo de CPU de cada fase de um quadro. As fases so
+//              marcadas em sequncia (cada marca encerra a fase iniciada pela
+//              anterior) e o relatrio traz a mdia e o pior caso de cada uma,
+//              em uma linha com formato fixo para comparar execues
+//
+**********************************************************************************/
+
+#include "Profiler.h"
+#include <sstream>
+
+// -------------------------------------------------------------------------------
+
+void Profiler::Begin()
+{
+    frameStart = mark = timer.Stamp();
+}
+
+// -------------------------------------------------------------------------------
+
+void Profiler::Mark(const char* name)
+{
+    double elapsed = timer.Elapsed(mark) * 1000.0;
+    mark = timer.Stamp();
+
+    // poucas fases: a busca linear  mais barata que um mapa
+    Phase* phase = nullptr;
+    for (Phase& p : phases)
+    {
+        if (p.name == name)
+        {
+            phase = &p;
+            break;
+        }
+    }
+
+    if (!phase)
+    {
+        phases.push_back({ name });
+        phase = &phases.back();
+    }
+
+    phase->total += elapsed;
+    if (elapsed > phase->worst)
+        phase->worst = elapsed;
+}
+
+// -------------------------------------------------------------------------------
+
+void Profiler::End()
+{
+    double elapsed = timer.Elapsed(frameStart) * 1000.0;
+
+    frameTotal += elapsed;
+    if (elapsed > frameWorst)
+        frameWorst = elapsed;
+
+    ++frames;
+}
+
+// -------------------------------------------------------------------------------
+
+string Profiler::Report()
+{
+    std::ostringstream text;
+    text.precision(3);
+    text << std::fixed << frames << " quadros (media/pior ms):";
+
+    double scale = frames ? 1.0 / frames : 0.0;
+
+    for (Phase& p : phases)
+    {
+        text << " " << p.name << " " << p.total * scale << "/" << p.worst << " |";
+        p.total = p.worst = 0.0;
+    }
+
+    text << " quadro " << frameTotal * scale << "/" << frameWorst << "\n";
+
+    frameTotal = frameWorst = 0.0;
+    frames = 0;
+
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
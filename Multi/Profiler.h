@@ -0,0 +1,60 @@
+/**********************************************************************************
+// Profiler (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Mede o tempo de CPU de cada fase de um quadro. As fases so
+//              marcadas em sequncia (cada marca encerra a fase iniciada pela
+//              anterior) e o relatrio traz a mdia e o pior caso de cada uma,
+//              em uma linha com formato fixo para comparar execues
+//
+**********************************************************************************/
+
+#ifndef DXUT_PROFILER_H_
+#define DXUT_PROFILER_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include "Timer.h"
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+class Profiler
+{
+private:
+    struct Phase
+    {
+        string name;                        // nome da fase
+        double total = 0.0;                 // soma dos tempos desde o ltimo relatrio
+        double worst = 0.0;                 // maior tempo em um quadro
+    };
+
+    vector<Phase> phases;                   // fases na ordem da primeira marcao
+    Timer timer;                            // contador de alta preciso
+    llong mark = 0;                         // instante da ltima marca
+    llong frameStart = 0;                   // instante do incio do quadro
+    double frameTotal = 0.0;                // soma das duraes de quadro
+    double frameWorst = 0.0;                // quadro mais longo
+    uint frames = 0;                        // quadros desde o ltimo relatrio
+
+public:
+    void Begin();                           // inicia um quadro
+    void Mark(const char* name);            // encerra a fase atual com o nome dado
+    void End();                             // encerra o quadro
+    uint Frames() const                     // quadros acumulados
+    { return frames; }
+
+    // mdias e piores casos em milissegundos; zera os acumuladores
+    string Report();
+};
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,386 @@
+/**********************************************************************************
+// SceneGraph (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Hierarquia de transformaes guardada em vetores planos, em
+//              pr-ordem: cada n vem antes dos seus filhos e cada subrvore
+//              ocupa uma faixa contgua. As matrizes de mundo so calculadas
+//              em uma nica passagem linear, com o pai j resolvido quando o
+//              filho  visitado, e apenas as subrvores sujas so refeitas.
+//              Cada n guarda posio, rotao e escala separadas; a matriz
+//              local s  composta quando uma delas muda. A remoo apenas marca
+//              o n como morto e os vetores so compactados uma vez no Update
+//
+**********************************************************************************/
+
+#include "SceneGraph.h"
+#include "Parallel.h"
+#include <algorithm>
+
+// -------------------------------------------------------------------------------
+
+const uint ParallelNodes = 8192;            // ns mnimos por thread no Update
+
+// -------------------------------------------------------------------------------
+
+XMMATRIX TransformMatrix(const Transform& t)
+{
+    XMMATRIX m = XMMatrixRotationQuaternion(XMLoadFloat4(&t.rotation));
+    XMVECTOR scale = XMLoadFloat3(&t.scale);
+
+    m.r[0] = XMVectorMultiply(m.r[0], XMVectorSplatX(scale));
+    m.r[1] = XMVectorMultiply(m.r[1], XMVectorSplatY(scale));
+    m.r[2] = XMVectorMultiply(m.r[2], XMVectorSplatZ(scale));
+    m.r[3] = XMVectorSetW(XMLoadFloat3(&t.translation), 1.0f);
+
+    return m;
+}
+
+// -------------------------------------------------------------------------------
+
+Transform DecomposeTransform(FXMMATRIX m)
+{
+    XMVECTOR scale, rotation, translation;
+    XMMatrixDecompose(&scale, &rotation, &translation, m);
+
+    Transform t;
+    XMStoreFloat3(&t.scale, scale);
+    XMStoreFloat4(&t.rotation, XMQuaternionNormalize(rotation));
+    XMStoreFloat3(&t.translation, translation);
+    return t;
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Resize(uint node, int delta)
+{
+    // ancestrais vm antes na pr-ordem: suas posies no mudam com
+    // inseres ou remoes feitas dentro da subrvore
+    for (uint a = node; a != NoNode; a = parentIds[positions[a]])
+        sizes[positions[a]] += delta;
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Relink(uint from)
+{
+    uint count = uint(ids.size());
+
+    // ns mortos no tm identificador nem pai
+    for (uint i = from; i < count; ++i)
+        if (ids[i] != NoNode)
+            positions[ids[i]] = i;
+
+    for (uint i = from; i < count; ++i)
+        parents[i] = (parentIds[i] == NoNode) ? NoNode : positions[parentIds[i]];
+}
+
+// -------------------------------------------------------------------------------
+
+XMMATRIX SceneGraph::Compose(uint pos) const
+{
+    // no depende do ltimo Update: vale tambm para ns recm-criados ou alterados
+    XMMATRIX world = XMLoadFloat4x4A(&locals[pos]);
+
+    for (uint p = parents[pos]; p != NoNode; p = parents[p])
+        world = XMMatrixMultiply(world, XMLoadFloat4x4A(&locals[p]));
+
+    return world;
+}
+
+// -------------------------------------------------------------------------------
+
+uint SceneGraph::Create(const Transform& local, uint parent)
+{
+    uint id;
+    if (!freeIds.empty())
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else
+    {
+        id = uint(positions.size());
+        positions.push_back(NoNode);
+    }
+
+    // ltimo filho do pai: logo depois da sua subrvore (ou no fim, para razes)
+    uint pos = uint(ids.size());
+    if (parent != NoNode)
+        pos = positions[parent] + sizes[positions[parent]];
+
+    XMFLOAT4X4A matrix;
+    XMStoreFloat4x4A(&matrix, TransformMatrix(local));
+
+    transforms.insert(transforms.begin() + pos, local);
+    locals.insert(locals.begin() + pos, matrix);
+    worlds.insert(worlds.begin() + pos, matrix);
+    parents.insert(parents.begin() + pos, NoNode);
+    parentIds.insert(parentIds.begin() + pos, parent);
+    sizes.insert(sizes.begin() + pos, 1);
+    ids.insert(ids.begin() + pos, id);
+    dirty.insert(dirty.begin() + pos, 1);
+    changed.insert(changed.begin() + pos, 0);
+
+    Resize(parent, 1);
+    Relink(pos);
+
+    pending = true;
+    return id;
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Destroy(uint node)
+{
+    uint pos = positions[node];
+    uint parent = parentIds[pos];
+    uint last = uint(ids.size()) - 1;
+
+    // raiz sem filhos com outra raiz sem filhos no fim dos vetores: a ordem
+    // entre razes  livre, ento a ltima ocupa o lugar da removida
+    if (parent == NoNode && sizes[pos] == 1 && parentIds[last] == NoNode && sizes[last] == 1 && ids[last] != NoNode)
+    {
+        if (pos != last)
+        {
+            Apply([pos, last](auto& v) { v[pos] = v[last]; });
+            positions[ids[pos]] = pos;
+        }
+
+        Apply([](auto& v) { v.pop_back(); });
+
+        positions[node] = NoNode;
+        freeIds.push_back(node);
+        return;
+    }
+
+    XMMATRIX local = XMLoadFloat4x4A(&locals[pos]);
+
+    // os filhos diretos sobem um nvel: a matriz local do n removido entra
+    // na matriz local de cada filho, de forma que o mundo no muda
+    for (uint c = pos + 1; c < pos + sizes[pos]; c += sizes[c])
+    {
+        if (ids[c] == NoNode)
+            continue;
+
+        transforms[c] = DecomposeTransform(XMMatrixMultiply(XMLoadFloat4x4A(&locals[c]), local));
+        XMStoreFloat4x4A(&locals[c], TransformMatrix(transforms[c]));
+        parentIds[c] = parent;
+        parents[c] = parents[pos];
+        dirty[c] = 1;
+    }
+
+    // o n continua nos vetores como uma folha morta at o prximo Update:
+    // os ancestrais seguem contando a sua posio e os filhos, agora irmos,
+    // vm logo depois dele, de forma que a pr-ordem continua vlida
+    sizes[pos] = 1;
+    ids[pos] = NoNode;
+    parentIds[pos] = NoNode;
+    parents[pos] = NoNode;
+    dirty[pos] = 0;
+
+    positions[node] = NoNode;
+    freeIds.push_back(node);
+    ++dead;
+    pending = true;
+}
+
+// -------------------------------------------------------------------------------
+
+bool SceneGraph::SetParent(uint node, uint parent)
+{
+    uint pos = positions[node];
+    uint count = sizes[pos];
+
+    // o novo pai no pode estar dentro da subrvore movida
+    if (parent != NoNode && positions[parent] >= pos && positions[parent] < pos + count)
+        return false;
+
+    if (parentIds[pos] == parent)
+        return true;
+
+    // nova matriz local que mantm o mundo atual
+    XMMATRIX world = Compose(pos);
+    if (parent != NoNode)
+        world = XMMatrixMultiply(world, XMMatrixInverse(nullptr, Compose(positions[parent])));
+
+    // leva a subrvore para o fim dos vetores
+    Resize(parentIds[pos], -int(count));
+    Apply([pos, count](auto& v) { std::rotate(v.begin() + pos, v.begin() + pos + count, v.end()); });
+    Relink(pos);
+
+    // e dali para logo depois da subrvore do novo pai
+    uint last = uint(ids.size()) - count;
+    uint target = last;
+    if (parent != NoNode)
+        target = positions[parent] + sizes[positions[parent]];
+
+    Apply([target, last](auto& v) { std::rotate(v.begin() + target, v.begin() + last, v.end()); });
+
+    transforms[target] = DecomposeTransform(world);
+    XMStoreFloat4x4A(&locals[target], TransformMatrix(transforms[target]));
+    parentIds[target] = parent;
+    dirty[target] = 1;
+
+    Relink(target);
+    Resize(parent, int(count));
+
+    pending = true;
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::SetLocal(uint node, const Transform& local)
+{
+    // a matriz  composta aqui, uma vez por alterao, e no a cada Update
+    uint pos = positions[node];
+    transforms[pos] = local;
+    XMStoreFloat4x4A(&locals[pos], TransformMatrix(local));
+    dirty[pos] = 1;
+    pending = true;
+}
+
+// -------------------------------------------------------------------------------
+
+const Transform& SceneGraph::Local(uint node) const
+{
+    return transforms[positions[node]];
+}
+
+// -------------------------------------------------------------------------------
+
+XMMATRIX SceneGraph::World(uint node) const
+{
+    uint pos = positions[node];
+    return XMLoadFloat4x4A(parents[pos] == NoNode ? &locals[pos] : &worlds[pos]);
+}
+
+// -------------------------------------------------------------------------------
+
+uint SceneGraph::Parent(uint node) const
+{
+    return parentIds[positions[node]];
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Compact()
+{
+    uint count = uint(ids.size());
+    uint first = uint(std::find(ids.begin(), ids.end(), NoNode) - ids.begin());
+    uint write = first;
+
+    // remoo estvel: cada sequncia de ns vivos  movida em bloco
+    // e os ns vivos mantm a pr-ordem
+    for (uint i = first; i < count;)
+    {
+        while (i < count && ids[i] == NoNode)
+            ++i;
+
+        uint end = i;
+        while (end < count && ids[end] != NoNode)
+            ++end;
+
+        Apply([write, i, end](auto& v) { std::move(v.begin() + i, v.begin() + end, v.begin() + write); });
+        write += end - i;
+        i = end;
+    }
+
+    Apply([write](auto& v) { v.resize(write); });
+    dead = 0;
+
+    if (first < write)
+        Relink(first);
+
+    // os ancestrais ainda contavam os ns mortos: tamanhos refeitos de baixo
+    // para cima, j que o filho sempre vem depois do pai
+    std::fill(sizes.begin(), sizes.end(), 1u);
+    for (uint i = write; i-- > 0;)
+        if (parents[i] != NoNode)
+            sizes[parents[i]] += sizes[i];
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::UpdateRange(uint begin, uint end)
+{
+    // o pai sempre vem antes do filho: quando um n  visitado, o mundo
+    // e a marca de alterao do seu pai j so os deste Update
+    for (uint i = begin; i < end; ++i)
+    {
+        uint p = parents[i];
+        byte update = dirty[i] | (p != NoNode ? changed[p] : byte(0));
+
+        // escritas sem desvio: a mistura de ns sujos e limpos  imprevisvel
+        changed[i] = update;
+        dirty[i] = 0;
+
+        // o mundo de uma raiz  a sua matriz local: nada a copiar
+        if (p == NoNode || !update)
+            continue;
+
+        const XMFLOAT4X4A& parent = parents[p] == NoNode ? locals[p] : worlds[p];
+        XMStoreFloat4x4A(&worlds[i], XMMatrixMultiply(XMLoadFloat4x4A(&locals[i]), XMLoadFloat4x4A(&parent)));
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+const vector<uint>& SceneGraph::Update()
+{
+    if (dead)
+        Compact();
+
+    updated.clear();
+
+    // nada sujo: nenhum mundo muda
+    if (!pending)
+        return updated;
+
+    uint count = uint(ids.size());
+
+    // subrvores de razes diferentes no dependem umas das outras: cada
+    // faixa processa inteiras as subrvores cujas razes caem nela
+    ParallelFor(count, ParallelNodes, [this, count](uint begin, uint end)
+    {
+        uint first = begin;
+        while (first < count && parents[first] != NoNode)
+            ++first;
+
+        uint last = end > first ? end : first;
+        while (last < count && parents[last] != NoNode)
+            ++last;
+
+        UpdateRange(first, last);
+    });
+
+    // lista na pr-ordem montada sem desvios: cada identificador  escrito
+    // e o cursor s avana nos ns alterados
+    updated.resize(count);
+    uint n = 0;
+
+    for (uint i = 0; i < count; ++i)
+    {
+        updated[n] = ids[i];
+        n += changed[i];
+    }
+
+    updated.resize(n);
+
+    pending = false;
+    return updated;
+}
+
+// -------------------------------------------------------------------------------
+
+void SceneGraph::Reserve(uint count)
+{
+    Apply([count](auto& v) { v.reserve(count); });
+    positions.reserve(count);
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,113 @@
+/**********************************************************************************
+// SceneGraph (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Hierarquia de transformaes guardada em vetores planos, em
+//              pr-ordem: cada n vem antes dos seus filhos e cada subrvore
+//              ocupa uma faixa contgua. As matrizes de mundo so calculadas
+//              em uma nica passagem linear, com o pai j resolvido quando o
+//              filho  visitado, e apenas as subrvores sujas so refeitas.
+//              Cada n guarda posio, rotao e escala separadas; a matriz
+//              local s  composta quando uma delas muda. A remoo apenas marca
+//              o n como morto e os vetores so compactados uma vez no Update
+//
+**********************************************************************************/
+
+#ifndef DXUT_SCENEGRAPH_H_
+#define DXUT_SCENEGRAPH_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <vector>
+#include <DirectXMath.h>
+using namespace DirectX;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+const uint NoNode = uint(-1);               // n inexistente (pai das razes)
+
+// -------------------------------------------------------------------------------
+
+// transformao relativa ao pai: escala, depois rotao, depois translao
+struct Transform
+{
+    XMFLOAT3 translation = { 0.0f, 0.0f, 0.0f };        // posio
+    XMFLOAT4 rotation = { 0.0f, 0.0f, 0.0f, 1.0f };     // quaternion unitrio
+    XMFLOAT3 scale = { 1.0f, 1.0f, 1.0f };              // escala em cada eixo
+};
+
+// matriz equivalente a Scaling x RotationQuaternion x Translation, sem os dois
+// produtos de matrizes: a rotao  escalada linha a linha e a translao
+// ocupa a ltima linha
+XMMATRIX TransformMatrix(const Transform& t);
+
+// separa uma matriz afim em escala, rotao e translao (cisalhamento  perdido)
+Transform DecomposeTransform(FXMMATRIX m);
+
+// -------------------------------------------------------------------------------
+
+class SceneGraph
+{
+private:
+    // por posio na pr-ordem
+    vector<Transform> transforms;           // posio, rotao e escala relativas ao pai
+    vector<XMFLOAT4X4A> locals;             // matriz composta de transforms
+    vector<XMFLOAT4X4A> worlds;             // matriz de mundo do ltimo Update (no usada nas razes)
+    vector<uint> parents;                   // posio do pai (NoNode nas razes)
+    vector<uint> parentIds;                 // identificador do pai (NoNode nas razes)
+    vector<uint> sizes;                     // ns da subrvore, incluindo o prprio
+    vector<uint> ids;                       // identificador do n
+    vector<byte> dirty;                     // matriz local alterada desde o ltimo Update
+    vector<byte> changed;                   // matriz de mundo refeita na passagem atual do Update
+
+    // por identificador
+    vector<uint> positions;                 // posio do n (NoNode se o identificador est livre)
+    vector<uint> freeIds;                   // identificadores disponveis para reuso
+    vector<uint> updated;                   // ns com o mundo refeito no ltimo Update
+    uint dead = 0;                          // ns removidos ainda presentes nos vetores
+    bool pending = false;                   // h ns sujos
+
+    template<class F> void Apply(F f)       // aplica f em todos os vetores por posio
+    { f(transforms); f(locals); f(worlds); f(parents); f(parentIds); f(sizes); f(ids); f(dirty); f(changed); }
+
+    void Resize(uint node, int delta);      // soma delta ao tamanho da subrvore dos ancestrais de node
+    void Relink(uint from);                 // refaz posies e pais a partir de uma posio
+    XMMATRIX Compose(uint pos) const;       // mundo a partir das matrizes locais dos ancestrais
+    void UpdateRange(uint begin, uint end); // refaz os mundos sujos de subrvores inteiras
+    void Compact();                         // retira os ns mortos e refaz posies, pais e tamanhos
+
+public:
+    // cria um n como ltimo filho de parent e retorna o seu identificador
+    uint Create(const Transform& local, uint parent = NoNode);
+
+    // remove um n; os filhos passam ao av mantendo suas matrizes de mundo;
+    // custa apenas o nmero de filhos: o n fica marcado at o prximo Update
+    void Destroy(uint node);
+
+    // move a subrvore de um n para baixo de outro pai mantendo a matriz de
+    // mundo; retorna falso se o novo pai pertence  prpria subrvore
+    bool SetParent(uint node, uint parent);
+
+    void SetLocal(uint node, const Transform& local);   // altera transformao local e suja a subrvore
+    const Transform& Local(uint node) const;            // transformao local
+    XMMATRIX World(uint node) const;            // matriz de mundo do ltimo Update (nas razes, a local)
+    uint Parent(uint node) const;               // identificador do pai (ou NoNode)
+
+    // compacta os ns removidos, recalcula as matrizes de mundo das subrvores
+    // sujas em uma passagem linear e retorna os ns cujo mundo foi refeito
+    // (vlido at o prximo Update), na pr-ordem
+    const vector<uint>& Update();
+
+    void Reserve(uint count);               // reserva espao para count ns
+    uint Count() const                      // nmero de ns
+    { return uint(ids.size()) - dead; }
+};
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,66 @@
+/**********************************************************************************
+// Simd (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Lotes SIMD usados pelos laos em estrutura de arrays: cada
+//              registrador guarda o mesmo elemento de 4, 8 ou 16 objetos e as
+//              mesmas operaes so escritas uma vez, como templates, para
+//              SSE, AVX2 e AVX-512 (o nvel  escolhido por SimdLevel)
+//
+**********************************************************************************/
+
+#ifndef DXUT_SIMD_H_
+#define DXUT_SIMD_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <immintrin.h>
+
+// -------------------------------------------------------------------------------
+
+struct SimdSse
+{
+    using V = __m128;
+    static const uint Width = 4;
+    static V Load(const float* p) { return _mm_load_ps(p); }
+    static void Store(float* p, V v) { _mm_store_ps(p, v); }
+    static V Splat(float f) { return _mm_set1_ps(f); }
+    static V Add(V a, V b) { return _mm_add_ps(a, b); }
+    static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V MulAdd(V a, V b, V c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static uint Negative(V a) { return uint(_mm_movemask_ps(_mm_cmplt_ps(a, _mm_setzero_ps()))); }
+};
+
+struct SimdAvx2
+{
+    using V = __m256;
+    static const uint Width = 8;
+    static V Load(const float* p) { return _mm256_load_ps(p); }
+    static void Store(float* p, V v) { _mm256_store_ps(p, v); }
+    static V Splat(float f) { return _mm256_set1_ps(f); }
+    static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V MulAdd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+    static uint Negative(V a) { return uint(_mm256_movemask_ps(_mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_LT_OQ))); }
+};
+
+struct SimdAvx512
+{
+    using V = __m512;
+    static const uint Width = 16;
+    static V Load(const float* p) { return _mm512_load_ps(p); }
+    static void Store(float* p, V v) { _mm512_store_ps(p, v); }
+    static V Splat(float f) { return _mm512_set1_ps(f); }
+    static V Add(V a, V b) { return _mm512_add_ps(a, b); }
+    static V Mul(V a, V b) { return _mm512_mul_ps(a, b); }
+    static V MulAdd(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+    static uint Negative(V a) { return uint(_mm512_cmp_ps_mask(a, _mm512_setzero_ps(), _CMP_LT_OQ)); }
+};
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,559 @@
+/**********************************************************************************
+// Simplifier (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Simplifica malhas trianguladas por colapso de arestas guiado por
+//              qudricas de erro (Garland e Heckbert, 1997). Os vrtices no so
+//              movidos nem criados: cada colapso leva um vrtice at um vizinho,
+//              de forma que todos os nveis de detalhe podem compartilhar o mesmo
+//              vertex buffer e diferir apenas nos ndices
+//
+**********************************************************************************/
+
+#include "Simplifier.h"
+#include <climits>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+// Funes auxiliares
+
+// classificao topolgica dos vrtices
+enum VertexKinds { VERTEX_INTERIOR, VERTEX_BORDER, VERTEX_LOCKED };
+
+const float BorderWeight = 2.0f;            // peso das arestas de borda nas qudricas
+const float SeamWeight = 0.5f;              // peso das arestas de vinco nas qudricas
+
+// -------------------------------------------------------------------------------
+
+// qudrica de erro: soma ponderada das distncias ao quadrado at um conjunto de planos
+struct Quadric
+{
+    float a00, a11, a22, a10, a20, a21;     // matriz simtrica A = n * n^T
+    float b0, b1, b2;                       // vetor b = d * n
+    float c;                                // constante d * d
+    float w;                                // soma dos pesos
+
+    // plano n.p + d = 0 com normal unitria
+    void Plane(float nx, float ny, float nz, float d, float weight)
+    {
+        a00 = weight * nx * nx; a11 = weight * ny * ny; a22 = weight * nz * nz;
+        a10 = weight * ny * nx; a20 = weight * nz * nx; a21 = weight * nz * ny;
+        b0 = weight * nx * d; b1 = weight * ny * d; b2 = weight * nz * d;
+        c = weight * d * d;
+        w = weight;
+    }
+
+    void Add(const Quadric& q)
+    {
+        a00 += q.a00; a11 += q.a11; a22 += q.a22;
+        a10 += q.a10; a20 += q.a20; a21 += q.a21;
+        b0 += q.b0; b1 += q.b1; b2 += q.b2;
+        c += q.c;
+        w += q.w;
+    }
+
+    // mdia ponderada das distncias ao quadrado do ponto p aos planos
+    float Error(const float* p) const
+    {
+        float x = p[0], y = p[1], z = p[2];
+        float rx = a00 * x + a10 * y + a20 * z;
+        float ry = a10 * x + a11 * y + a21 * z;
+        float rz = a20 * x + a21 * y + a22 * z;
+        float r = rx * x + ry * y + rz * z + 2.0f * (b0 * x + b1 * y + b2 * z) + c;
+        return w > 0.0f ? fabsf(r) / w : 0.0f;
+    }
+};
+
+// -------------------------------------------------------------------------------
+
+// conjunto de arestas orientadas (a,b) com endereamento aberto
+struct EdgeSet
+{
+    vector<ullong> keys;
+    size_t mask = 0;
+
+    void Reset(size_t count)
+    {
+        size_t capacity = 16;
+        while (capacity < count * 2)
+            capacity <<= 1;
+        keys.assign(capacity, ~0ull);
+        mask = capacity - 1;
+    }
+
+    static size_t Hash(ullong key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdull;
+        key ^= key >> 33;
+        return size_t(key);
+    }
+
+    void Insert(uint a, uint b)
+    {
+        ullong key = (ullong(a) << 32) | b;
+        size_t slot = Hash(key) & mask;
+        while (keys[slot] != ~0ull && keys[slot] != key)
+            slot = (slot + 1) & mask;
+        keys[slot] = key;
+    }
+
+    bool Contains(uint a, uint b) const
+    {
+        ullong key = (ullong(a) << 32) | b;
+        size_t slot = Hash(key) & mask;
+        while (keys[slot] != ~0ull)
+        {
+            if (keys[slot] == key)
+                return true;
+            slot = (slot + 1) & mask;
+        }
+        return false;
+    }
+};
+
+// -------------------------------------------------------------------------------
+
+// colapso candidato: leva o vrtice from at a posio do vrtice to
+struct Collapse
+{
+    uint from;
+    uint to;
+    float cost;
+};
+
+// -------------------------------------------------------------------------------
+
+// plano perpendicular ao tringulo que passa pela aresta p0-p1: mantm a aresta no lugar
+static void EdgeQuadric(Quadric& q, const float* p0, const float* p1, const float* normal, float weight)
+{
+    float e[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    float length = sqrtf(e[0] * e[0] + e[1] * e[1] + e[2] * e[2]);
+
+    float n[3] = {
+        e[1] * normal[2] - e[2] * normal[1],
+        e[2] * normal[0] - e[0] * normal[2],
+        e[0] * normal[1] - e[1] * normal[0] };
+    float nl = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+    if (nl == 0.0f)
+    {
+        q.Plane(0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        return;
+    }
+
+    n[0] /= nl; n[1] /= nl; n[2] /= nl;
+    q.Plane(n[0], n[1], n[2], -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]), length * length * weight);
+}
+
+// -------------------------------------------------------------------------------
+
+// normal no normalizada do tringulo (p0,p1,p2)
+static void TriangleNormal(float* n, const float* p0, const float* p1, const float* p2)
+{
+    float u[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    float v[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+    n[0] = u[1] * v[2] - u[2] * v[1];
+    n[1] = u[2] * v[0] - u[0] * v[2];
+    n[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+// -------------------------------------------------------------------------------
+
+uint SimplifyMesh(uint* destination, const uint* indices, uint indexCount,
+    const float* positions, uint vertexCount, uint vertexStride,
+    uint targetIndexCount, float targetError, float* resultError)
+{
+    uint count = indexCount / 3 * 3;
+    uint* tris = destination;
+    memmove(destination, indices, count * sizeof(uint));
+
+    if (resultError)
+        *resultError = 0.0f;
+
+    if (count <= targetIndexCount || vertexCount == 0)
+        return count;
+
+    // ---------------------------------------------------------------------------
+    // posies normalizadas no cubo unitrio (preciso das qudricas)
+
+    const byte* data = reinterpret_cast<const byte*>(positions);
+    vector<float> points(size_t(vertexCount) * 3);
+
+    float minP[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float maxP[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (uint v = 0; v < vertexCount; ++v)
+    {
+        const float* p = reinterpret_cast<const float*>(data + size_t(v) * vertexStride);
+        for (uint k = 0; k < 3; ++k)
+        {
+            points[size_t(v) * 3 + k] = p[k];
+            minP[k] = std::min(minP[k], p[k]);
+            maxP[k] = std::max(maxP[k], p[k]);
+        }
+    }
+
+    float extent = std::max(maxP[0] - minP[0], std::max(maxP[1] - minP[1], maxP[2] - minP[2]));
+    float scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+
+    for (uint v = 0; v < vertexCount; ++v)
+        for (uint k = 0; k < 3; ++k)
+            points[size_t(v) * 3 + k] = (points[size_t(v) * 3 + k] - minP[k]) * scale;
+
+    auto point = [&](uint v) { return &points[size_t(v) * 3]; };
+
+    // erro mximo na mesma escala das qudricas (distncia ao quadrado)
+    float errorLimit = targetError * scale;
+    errorLimit = (errorLimit < sqrtf(FLT_MAX) ? errorLimit * errorLimit : FLT_MAX);
+
+    // ---------------------------------------------------------------------------
+    // cpias de um vrtice (mesma posio, atributos diferentes) formam uma lista
+    // circular; o primeiro vrtice da lista representa a posio
+
+    vector<uint> rep(vertexCount);
+    vector<uint> nextCopy(vertexCount);
+    {
+        size_t capacity = 16;
+        while (capacity < size_t(vertexCount) * 2)
+            capacity <<= 1;
+
+        vector<uint> table(capacity, UINT_MAX);
+
+        for (uint v = 0; v < vertexCount; ++v)
+        {
+            const float* p = point(v);
+            uint bits[3];
+            for (uint k = 0; k < 3; ++k)
+            {
+                float f = p[k] + 0.0f;      // -0 e +0 tm o mesmo hash
+                memcpy(&bits[k], &f, sizeof(float));
+            }
+
+            size_t slot = ((bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u)) & (capacity - 1);
+            while (table[slot] != UINT_MAX && memcmp(point(table[slot]), p, 3 * sizeof(float)) != 0)
+                slot = (slot + 1) & (capacity - 1);
+
+            if (table[slot] == UINT_MAX)
+            {
+                table[slot] = v;
+                rep[v] = v;
+                nextCopy[v] = v;
+            }
+            else
+            {
+                uint r = table[slot];
+                rep[v] = r;
+                nextCopy[v] = nextCopy[r];
+                nextCopy[r] = v;
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------
+    // qudricas dos tringulos, das bordas abertas e dos vincos
+
+    vector<Quadric> quadrics(vertexCount);
+    memset(quadrics.data(), 0, quadrics.size() * sizeof(Quadric));
+
+    EdgeSet welded;                         // arestas entre posies
+    EdgeSet original;                       // arestas entre vrtices
+    welded.Reset(count);
+    original.Reset(count);
+
+    for (uint i = 0; i < count; i += 3)
+        for (uint e = 0; e < 3; ++e)
+        {
+            uint a = tris[i + e], b = tris[i + (e + 1) % 3];
+            welded.Insert(rep[a], rep[b]);
+            original.Insert(a, b);
+        }
+
+    vector<uint> openEdges(vertexCount, 0);
+
+    for (uint i = 0; i < count; i += 3)
+    {
+        const float* p[3] = { point(tris[i]), point(tris[i + 1]), point(tris[i + 2]) };
+
+        float n[3];
+        TriangleNormal(n, p[0], p[1], p[2]);
+        float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+        if (length == 0.0f)
+            continue;
+
+        n[0] /= length; n[1] /= length; n[2] /= length;
+
+        Quadric q;
+        q.Plane(n[0], n[1], n[2], -(n[0] * p[0][0] + n[1] * p[0][1] + n[2] * p[0][2]), 0.5f * length);
+
+        for (uint c = 0; c < 3; ++c)
+            quadrics[rep[tris[i + c]]].Add(q);
+
+        for (uint e = 0; e < 3; ++e)
+        {
+            uint a = tris[i + e], b = tris[i + (e + 1) % 3];
+            uint ra = rep[a], rb = rep[b];
+
+            float weight = 0.0f;
+
+            if (!welded.Contains(rb, ra))
+            {
+                // borda aberta: nenhum tringulo do outro lado
+                ++openEdges[ra];
+                ++openEdges[rb];
+                weight = BorderWeight;
+            }
+            else if (!original.Contains(b, a))
+            {
+                // vinco: o tringulo vizinho usa outras cpias dos vrtices
+                weight = SeamWeight;
+            }
+
+            if (weight > 0.0f)
+            {
+                EdgeQuadric(q, p[e], p[(e + 1) % 3], n, weight);
+                quadrics[ra].Add(q);
+                quadrics[rb].Add(q);
+            }
+        }
+    }
+
+    // vrtices em mais de uma borda (bordas que se tocam) no se movem
+    vector<byte> kind(vertexCount, VERTEX_INTERIOR);
+    for (uint v = 0; v < vertexCount; ++v)
+        if (openEdges[v] > 2)
+            kind[v] = VERTEX_LOCKED;
+        else if (openEdges[v] > 0)
+            kind[v] = VERTEX_BORDER;
+
+    // ---------------------------------------------------------------------------
+    // passos de colapso: cada passo escolhe colapsos independentes entre si em
+    // ordem crescente de custo e reescreve os tringulos de uma vez
+
+    vector<uint> offsets(size_t(vertexCount) + 1);
+    vector<uint> adjacency;
+    vector<uint> cursor;
+    vector<Collapse> candidates;
+    vector<uint> remap(vertexCount);
+    vector<byte> state(vertexCount);        // 0 livre, 1 no pode sair do lugar, 2 colapsado
+    vector<uint> targets;                   // cpia de destino de cada cpia da origem
+
+    float maxError = 0.0f;
+
+    while (count > targetIndexCount)
+    {
+        // tringulos ao redor de cada posio
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (uint i = 0; i < count; ++i)
+            ++offsets[size_t(rep[tris[i]]) + 1];
+        for (uint v = 0; v < vertexCount; ++v)
+            offsets[size_t(v) + 1] += offsets[v];
+
+        adjacency.resize(count);
+        cursor.assign(offsets.begin(), offsets.end() - 1);
+        for (uint i = 0; i < count; ++i)
+            adjacency[cursor[rep[tris[i]]]++] = i / 3;
+
+        welded.Reset(count);
+        for (uint i = 0; i < count; i += 3)
+            for (uint e = 0; e < 3; ++e)
+                welded.Insert(rep[tris[i + e]], rep[tris[i + (e + 1) % 3]]);
+
+        // custo de levar a at b (FLT_MAX quando a topologia no permite)
+        auto cost = [&](uint a, uint b, bool open)
+        {
+            if (kind[a] == VERTEX_LOCKED || (kind[a] == VERTEX_BORDER && !open))
+                return FLT_MAX;
+            return quadrics[a].Error(point(b));
+        };
+
+        candidates.clear();
+        for (uint i = 0; i < count; i += 3)
+            for (uint e = 0; e < 3; ++e)
+            {
+                uint a = rep[tris[i + e]], b = rep[tris[i + (e + 1) % 3]];
+                if (a == b)
+                    continue;
+
+                // arestas internas aparecem nos dois sentidos: avalia uma vez
+                bool open = !welded.Contains(b, a);
+                if (!open && a > b)
+                    continue;
+
+                float ab = cost(a, b, open);
+                float ba = cost(b, a, open);
+
+                if (ab < FLT_MAX || ba < FLT_MAX)
+                    candidates.push_back(ab <= ba ? Collapse{ a, b, ab } : Collapse{ b, a, ba });
+            }
+
+        if (candidates.empty())
+            break;
+
+        std::sort(candidates.begin(), candidates.end(),
+            [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+        // tringulos a remover; cada colapso remove em geral dois tringulos
+        uint needed = (count - targetIndexCount + 2) / 3;
+
+        // no aceita colapsos muito mais caros que os necessrios para o passo,
+        // pois colapsos baratos bloqueados neste passo ficam disponveis no prximo
+        size_t rank = std::min(candidates.size() - 1, size_t(needed / 2));
+        float passLimit = std::min(errorLimit, candidates[rank].cost * 1.5f);
+
+        uint removed = 0;
+        uint collapses = 0;
+
+        for (uint attempt = 0; attempt < 2 && collapses == 0; ++attempt)
+        {
+            for (uint v = 0; v < vertexCount; ++v)
+                remap[v] = v;
+            std::fill(state.begin(), state.end(), byte(0));
+
+            for (const Collapse& cand : candidates)
+            {
+                if (cand.cost > passLimit || removed >= needed)
+                    break;
+
+                uint a = cand.from, b = cand.to;
+                if (state[a] != 0 || state[b] == 2)
+                    continue;
+
+                // cada cpia de a segue a cpia de b que  sua vizinha, de forma que
+                // os atributos continuam corretos ao longo dos vincos; cpias sem
+                // vizinha (colapso que atravessa um vinco) seguem o prprio b
+                targets.clear();
+
+                uint ai = a;
+                do
+                {
+                    uint target = UINT_MAX;
+                    bool used = false;
+
+                    for (uint k = offsets[a]; k < offsets[size_t(a) + 1]; ++k)
+                    {
+                        const uint* tri = &tris[size_t(adjacency[k]) * 3];
+                        if (tri[0] != ai && tri[1] != ai && tri[2] != ai)
+                            continue;
+
+                        used = true;
+                        for (uint c = 0; c < 3 && target == UINT_MAX; ++c)
+                            if (rep[tri[c]] == b)
+                                target = tri[c];
+                    }
+
+                    if (!used)
+                        target = ai;
+                    else if (target == UINT_MAX)
+                        target = b;
+
+                    targets.push_back(target);
+                    ai = nextCopy[ai];
+                }
+                while (ai != a);
+
+                // rejeita colapsos que invertem tringulos vizinhos
+                bool valid = true;
+                uint shared = 0;
+                for (uint k = offsets[a]; k < offsets[size_t(a) + 1] && valid; ++k)
+                {
+                    const uint* tri = &tris[size_t(adjacency[k]) * 3];
+                    const float* p[3] = { point(rep[tri[0]]), point(rep[tri[1]]), point(rep[tri[2]]) };
+                    const float* q[3] = { p[0], p[1], p[2] };
+
+                    bool hasB = false;
+                    for (uint c = 0; c < 3; ++c)
+                    {
+                        hasB |= (rep[tri[c]] == b);
+                        if (rep[tri[c]] == a)
+                            q[c] = point(b);
+                    }
+
+                    if (hasB)
+                    {
+                        ++shared;
+                        continue;
+                    }
+
+                    float n0[3], n1[3];
+                    TriangleNormal(n0, p[0], p[1], p[2]);
+                    TriangleNormal(n1, q[0], q[1], q[2]);
+
+                    float d = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+                    float l0 = n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2];
+                    float l1 = n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2];
+
+                    if (d <= 0.25f * sqrtf(l0 * l1))
+                        valid = false;
+                }
+
+                if (!valid)
+                    continue;
+
+                // executa o colapso
+                ai = a;
+                for (uint target : targets)
+                {
+                    remap[ai] = target;
+                    ai = nextCopy[ai];
+                }
+
+                quadrics[b].Add(quadrics[a]);
+
+                // vizinhos de a no se movem neste passo: os testes
+                // acima supem que seus tringulos continuam iguais
+                state[a] = 2;
+                for (uint k = offsets[a]; k < offsets[size_t(a) + 1]; ++k)
+                {
+                    const uint* tri = &tris[size_t(adjacency[k]) * 3];
+                    for (uint c = 0; c < 3; ++c)
+                        if (state[rep[tri[c]]] == 0)
+                            state[rep[tri[c]]] = 1;
+                }
+
+                maxError = std::max(maxError, cand.cost);
+                removed += shared;
+                ++collapses;
+            }
+
+            // nenhum colapso dentro do limite do passo: tenta sem o limite
+            passLimit = errorLimit;
+        }
+
+        if (collapses == 0)
+            break;
+
+        // reescreve os tringulos e descarta os degenerados
+        uint write = 0;
+        for (uint i = 0; i < count; i += 3)
+        {
+            uint v0 = remap[tris[i]], v1 = remap[tris[i + 1]], v2 = remap[tris[i + 2]];
+            uint r0 = rep[v0], r1 = rep[v1], r2 = rep[v2];
+
+            if (r0 == r1 || r1 == r2 || r2 == r0)
+                continue;
+
+            tris[write++] = v0;
+            tris[write++] = v1;
+            tris[write++] = v2;
+        }
+
+        count = write;
+    }
+
+    if (resultError)
+        *resultError = sqrtf(maxError) / scale;
+
+    return count;
+}
+
+// -------------------------------------------------------------------------------
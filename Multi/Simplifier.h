@@ -0,0 +1,43 @@
+/**********************************************************************************
+// Simplifier (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Simplifica malhas trianguladas por colapso de arestas guiado por
+//              qudricas de erro (Garland e Heckbert, 1997). Os vrtices no so
+//              movidos nem criados: cada colapso leva um vrtice at um vizinho,
+//              de forma que todos os nveis de detalhe podem compartilhar o mesmo
+//              vertex buffer e diferir apenas nos ndices
+//
+**********************************************************************************/
+
+#ifndef DXUT_SIMPLIFIER_H_
+#define DXUT_SIMPLIFIER_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <cfloat>
+
+// -------------------------------------------------------------------------------
+
+// reduz a malha at targetIndexCount ndices ou at o erro passar de targetError;
+// bordas abertas s colapsam ao longo da prpria borda e vincos (vrtices duplicados
+// com a mesma posio) pesam no custo dos colapsos; retorna o nmero de ndices
+// gravados em destination (que pode ser a entrada)
+uint SimplifyMesh(
+    uint* destination,                      // ndices simplificados (indexCount posies)
+    const uint* indices,                    // ndices da malha (lista de tringulos)
+    uint indexCount,                        // nmero de ndices
+    const float* positions,                 // posio (x,y,z) do primeiro vrtice
+    uint vertexCount,                       // nmero de vrtices
+    uint vertexStride,                      // distncia em bytes entre posies
+    uint targetIndexCount,                  // nmero de ndices desejado
+    float targetError = FLT_MAX,            // erro mximo aceito (distncia no espao do objeto)
+    float* resultError = nullptr);          // erro da malha simplificada (opcional)
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,166 @@
+/**********************************************************************************
+// SlotMap (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Continer com insero e remoo em tempo constante e handles
+//              estveis. Os elementos ficam contguos (a remoo move o ltimo
+//              para o lugar do removido) e cada handle aponta para uma entrada
+//              indireta com contador de gerao, de forma que handles de
+//              elementos removidos so reconhecidos como invlidos
+//
+**********************************************************************************/
+
+#ifndef DXUT_SLOTMAP_H_
+#define DXUT_SLOTMAP_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <vector>
+#include <utility>
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// referncia estvel para um elemento de um SlotMap
+struct Handle
+{
+    uint slot = uint(-1);                   // entrada indireta do elemento
+    uint generation = 0;                    // gerao da entrada quando o handle foi criado
+
+    bool operator==(const Handle& other) const
+    { return slot == other.slot && generation == other.generation; }
+
+    bool operator!=(const Handle& other) const
+    { return !(*this == other); }
+};
+
+// -------------------------------------------------------------------------------
+
+template<class T>
+class SlotMap
+{
+private:
+    struct Slot
+    {
+        uint index;                         // posio do elemento (ou prxima entrada livre)
+        uint generation;                    // incrementada a cada remoo
+    };
+
+    vector<T> items;                        // elementos contguos
+    vector<uint> owners;                    // entrada indireta de cada elemento
+    vector<Slot> slots;                     // entradas indiretas
+    uint freeList = uint(-1);               // primeira entrada livre
+
+public:
+    // insere um elemento no fim e retorna o seu handle
+    template<class U>
+    Handle Insert(U&& item)
+    {
+        uint slot;
+        if (freeList != uint(-1))
+        {
+            slot = freeList;
+            freeList = slots[slot].index;
+        }
+        else
+        {
+            slot = uint(slots.size());
+            slots.push_back({ 0, 0 });
+        }
+
+        slots[slot].index = uint(items.size());
+        items.push_back(std::forward<U>(item));
+        owners.push_back(slot);
+
+        return { slot, slots[slot].generation };
+    }
+
+    // remove um elemento movendo o ltimo para o seu lugar;
+    // retorna falso se o handle no  mais vlido
+    bool Erase(Handle handle)
+    {
+        if (!Contains(handle))
+            return false;
+
+        uint index = slots[handle.slot].index;
+        uint last = uint(items.size()) - 1;
+
+        if (index != last)
+        {
+            items[index] = std::move(items[last]);
+            owners[index] = owners[last];
+            slots[owners[index]].index = index;
+        }
+
+        items.pop_back();
+        owners.pop_back();
+
+        // a entrada vai para a lista livre e invalida os handles existentes
+        slots[handle.slot].index = freeList;
+        slots[handle.slot].generation++;
+        freeList = handle.slot;
+
+        return true;
+    }
+
+    bool Contains(Handle handle) const      // handle aponta para um elemento existente
+    { return handle.slot < slots.size() && slots[handle.slot].generation == handle.generation; }
+
+    T* Get(Handle handle)                   // elemento do handle ou nullptr
+    { return Contains(handle) ? &items[slots[handle.slot].index] : nullptr; }
+
+    const T* Get(Handle handle) const       // elemento do handle ou nullptr
+    { return Contains(handle) ? &items[slots[handle.slot].index] : nullptr; }
+
+    uint IndexOf(Handle handle) const       // posio atual de um elemento vlido
+    { return slots[handle.slot].index; }
+
+    Handle HandleAt(uint index) const       // handle do elemento em uma posio
+    { return { owners[index], slots[owners[index]].generation }; }
+
+    void Reserve(uint count)                // reserva espao para count elementos
+    { items.reserve(count); owners.reserve(count); slots.reserve(count); }
+
+    uint Capacity() const                   // elementos que cabem sem realocar
+    { return uint(items.capacity()); }
+
+    void Clear()                            // remove todos os elementos e invalida os handles
+    {
+        for (uint index = 0; index < items.size(); ++index)
+        {
+            Slot& slot = slots[owners[index]];
+            slot.index = freeList;
+            slot.generation++;
+            freeList = owners[index];
+        }
+
+        items.clear();
+        owners.clear();
+    }
+
+    uint Size() const                       // nmero de elementos
+    { return uint(items.size()); }
+
+    bool Empty() const                      // no h elementos
+    { return items.empty(); }
+
+    T& operator[](uint index)               // elemento em uma posio
+    { return items[index]; }
+
+    const T& operator[](uint index) const   // elemento em uma posio
+    { return items[index]; }
+
+    // percorre os elementos na ordem contgua
+    typename vector<T>::iterator begin() { return items.begin(); }
+    typename vector<T>::iterator end() { return items.end(); }
+    typename vector<T>::const_iterator begin() const { return items.begin(); }
+    typename vector<T>::const_iterator end() const { return items.end(); }
+};
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,436 @@
+/**********************************************************************************
+// Terrain (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Terreno construdo a partir de um mapa de alturas e dividido em
+//              peas quadradas (geomipmapping). Todas as peas compartilham o
+//              mesmo vertex buffer e uma nica tabela de ndices, gerada a partir
+//              do Grid para cada nvel de detalhe e cada combinao de bordas
+//              costuradas com vizinhos um nvel mais simples. O nvel de cada
+//              pea  escolhido por vista a partir do erro projetado na tela
+//
+**********************************************************************************/
+
+#include "Terrain.h"
+#include "Arena.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// -------------------------------------------------------------------------------
+// Funes auxiliares
+
+// valor pseudoaleatrio em [0,1] para um ponto inteiro da rede de rudo
+static float LatticeValue(int x, int z, uint seed)
+{
+    uint h = uint(x) * 73856093u ^ uint(z) * 19349663u ^ seed * 83492791u;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return float(h & 0xffffff) / float(0xffffff);
+}
+
+// rudo de valor com interpolao suave entre os pontos da rede
+static float ValueNoise(float x, float z, uint seed)
+{
+    int x0 = int(floorf(x));
+    int z0 = int(floorf(z));
+    float u = x - x0;
+    float v = z - z0;
+
+    u = u * u * (3.0f - 2.0f * u);
+    v = v * v * (3.0f - 2.0f * v);
+
+    float a = LatticeValue(x0, z0, seed);
+    float b = LatticeValue(x0 + 1, z0, seed);
+    float c = LatticeValue(x0, z0 + 1, seed);
+    float d = LatticeValue(x0 + 1, z0 + 1, seed);
+
+    return (a + (b - a) * u) + ((c + (d - c) * u) - (a + (b - a) * u)) * v;
+}
+
+// -------------------------------------------------------------------------------
+
+Heightmap GenerateHeightmap(uint width, uint depth, float height, uint seed)
+{
+    Heightmap map;
+    map.width = width;
+    map.depth = depth;
+    map.heights.resize(size_t(width) * depth);
+
+    // a menor frequncia cobre o mapa com cerca de 4 ondulaes
+    float baseFrequency = 4.0f / float(std::max(width, depth));
+
+    ParallelFor(depth, 64, [&](uint begin, uint end)
+    {
+        for (uint row = begin; row < end; ++row)
+        {
+            for (uint col = 0; col < width; ++col)
+            {
+                float sum = 0.0f;
+                float amplitude = 1.0f;
+                float frequency = baseFrequency;
+
+                for (uint octave = 0; octave < 6; ++octave)
+                {
+                    sum += amplitude * ValueNoise(col * frequency, row * frequency, seed + octave);
+                    amplitude *= 0.5f;
+                    frequency *= 2.0f;
+                }
+
+                map.heights[size_t(row) * width + col] = sum;
+            }
+        }
+    });
+
+    // ajusta as alturas para o intervalo [0, height]
+    auto range = std::minmax_element(map.heights.begin(), map.heights.end());
+    float low = *range.first;
+    float scale = *range.second > low ? height / (*range.second - low) : 0.0f;
+
+    for (float& h : map.heights)
+        h = (h - low) * scale;
+
+    return map;
+}
+
+// -------------------------------------------------------------------------------
+
+// altura de um ponto dentro de uma clula do Grid, interpolada no tringulo que o
+// contm: a diagonal da clula liga o canto (0,1) ao canto (1,0), como no Grid
+static float CellHeight(float h00, float h01, float h10, float h11, float u, float v)
+{
+    if (u + v <= 1.0f)
+        return h00 + u * (h01 - h00) + v * (h10 - h00);
+
+    return h11 + (1.0f - u) * (h10 - h11) + (1.0f - v) * (h01 - h11);
+}
+
+//   _________
+// _/ Terrain \__________________________________________________________________
+// ------------------------------------------------------------------------------
+
+Terrain::Terrain(const Heightmap& map, float spacing, uint size)
+{
+    // ndices locais de 16 bits limitam a pea a 128 quads por lado
+    chunkSize = std::min(size, 128u);
+
+    uint side = chunkSize + 1;                  // vrtices por lado de uma pea
+    uint chunkVertices = side * side;
+
+    // amostras que no completam uma pea so ignoradas
+    chunkColumns = map.width > 1 ? (map.width - 1) / chunkSize : 0;
+    chunkRows = map.depth > 1 ? (map.depth - 1) / chunkSize : 0;
+
+    // o nvel mais simples desenha cada pea com 2 tringulos
+    levelCount = 1;
+    while ((1u << levelCount) <= chunkSize && levelCount < TerrainMaxLevels)
+        ++levelCount;
+
+    // terreno centralizado na origem, linhas avanando no sentido -z como no Grid
+    float halfWidth = 0.5f * spacing * (chunkColumns * chunkSize);
+    float halfDepth = 0.5f * spacing * (chunkRows * chunkSize);
+
+    // -----------------------------------------------------------
+    // Vrtices: as peas repetem as amostras das bordas, mas cada
+    // posio vem das coordenadas globais e  idntica nas duas
+    // -----------------------------------------------------------
+
+    chunks.resize(size_t(chunkColumns) * chunkRows);
+    vertices.resize(chunks.size() * chunkVertices);
+
+    // normais por diferenas centrais no mapa inteiro: contnuas entre as peas
+    auto Normal = [&](uint row, uint col)
+    {
+        uint left = col > 0 ? col - 1 : col;
+        uint right = col + 1 < map.width ? col + 1 : col;
+        uint up = row > 0 ? row - 1 : row;
+        uint down = row + 1 < map.depth ? row + 1 : row;
+
+        float dx = (map.At(row, right) - map.At(row, left)) / ((right - left) * spacing);
+        float dz = (map.At(up, col) - map.At(down, col)) / ((down - up) * spacing);
+
+        XMFLOAT3 n;
+        XMStoreFloat3(&n, XMVector3Normalize(XMVectorSet(-dx, 1.0f, -dz, 0.0f)));
+        return n;
+    };
+
+    ParallelFor(uint(chunks.size()), 1, [&](uint begin, uint end)
+    {
+        for (uint c = begin; c < end; ++c)
+        {
+            uint row0 = (c / chunkColumns) * chunkSize;
+            uint col0 = (c % chunkColumns) * chunkSize;
+
+            TerrainChunk& chunk = chunks[c];
+            chunk.baseVertex = c * chunkVertices;
+
+            float low = FLT_MAX;
+            float high = -FLT_MAX;
+
+            for (uint i = 0; i < side; ++i)
+            {
+                for (uint j = 0; j < side; ++j)
+                {
+                    uint row = row0 + i;
+                    uint col = col0 + j;
+                    float h = map.At(row, col);
+
+                    Vertex& v = vertices[chunk.baseVertex + size_t(i) * side + j];
+                    v.pos = XMFLOAT3(-halfWidth + col * spacing, h, halfDepth - row * spacing);
+                    v.color = XMFLOAT4(Colors::Yellow);
+                    v.normal = Normal(row, col);
+
+                    low = std::min(low, h);
+                    high = std::max(high, h);
+                }
+            }
+
+            // esfera envolvente da caixa da pea, usada no descarte por vista
+            float extent = 0.5f * spacing * chunkSize;
+            chunk.sphere.center = XMFLOAT3(
+                -halfWidth + (col0 + 0.5f * chunkSize) * spacing,
+                0.5f * (low + high),
+                halfDepth - (row0 + 0.5f * chunkSize) * spacing);
+            chunk.sphere.radius = sqrtf(2.0f * extent * extent + 0.25f * (high - low) * (high - low));
+            chunk.sphere.coneCutoff = 1.0f;
+
+            // erro de cada nvel: maior diferena entre a altura de uma amostra e a
+            // altura dos tringulos do nvel naquele ponto (no diminui com o nvel)
+            for (uint level = 1; level < levelCount; ++level)
+            {
+                uint step = 1u << level;
+                float error = chunk.errors[level - 1];
+
+                for (uint i = 0; i <= chunkSize; ++i)
+                {
+                    for (uint j = 0; j <= chunkSize; ++j)
+                    {
+                        uint ci = std::min(i / step, chunkSize / step - 1) * step;
+                        uint cj = std::min(j / step, chunkSize / step - 1) * step;
+
+                        float h = CellHeight(
+                            map.At(row0 + ci, col0 + cj), map.At(row0 + ci, col0 + cj + step),
+                            map.At(row0 + ci + step, col0 + cj), map.At(row0 + ci + step, col0 + cj + step),
+                            float(j - cj) / step, float(i - ci) / step);
+
+                        error = std::max(error, fabsf(map.At(row0 + i, col0 + j) - h));
+                    }
+                }
+
+                chunk.errors[level] = error;
+            }
+        }
+    });
+
+    // -----------------------------------------------------------
+    // ndices: para cada nvel, o Grid com (chunkSize / step + 1)
+    // vrtices por lado fornece os tringulos; nas bordas costuradas
+    // os vrtices mpares do nvel so levados ao vrtice par anterior,
+    // ficando sobre a aresta da vizinha, e os tringulos degenerados
+    // desaparecem
+    // -----------------------------------------------------------
+
+    variants.resize(size_t(levelCount) * 16);
+
+    for (uint level = 0; level < levelCount; ++level)
+    {
+        uint step = 1u << level;
+        uint cells = chunkSize / step;
+        Grid lattice(1.0f, 1.0f, cells + 1, cells + 1);
+
+        for (uint mask = 0; mask < 16; ++mask)
+        {
+            // vizinhas mais simples s existem abaixo do ltimo nvel
+            bool stitch = level + 1 < levelCount;
+
+            auto Snap = [&](uint latticeIndex)
+            {
+                uint i = latticeIndex / (cells + 1);
+                uint j = latticeIndex % (cells + 1);
+
+                if (stitch)
+                {
+                    if ((mask & 1) && i == 0 && (j & 1)) --j;
+                    if ((mask & 2) && j == cells && (i & 1)) --i;
+                    if ((mask & 4) && i == cells && (j & 1)) --j;
+                    if ((mask & 8) && j == 0 && (i & 1)) --i;
+                }
+
+                return (i * step) * side + j * step;
+            };
+
+            SubMesh& variant = variants[size_t(level) * 16 + mask];
+            variant.startIndex = IndexCount();
+
+            for (size_t t = 0; t < lattice.indices.size(); t += 3)
+            {
+                uint a = Snap(lattice.indices[t + 0]);
+                uint b = Snap(lattice.indices[t + 1]);
+                uint c = Snap(lattice.indices[t + 2]);
+
+                if (a == b || b == c || a == c)
+                    continue;
+
+                indices.push_back(a);
+                indices.push_back(b);
+                indices.push_back(c);
+            }
+
+            variant.indexCount = IndexCount() - variant.startIndex;
+        }
+    }
+
+    // cada variao  reordenada para o cache de vrtices, como uma malha prpria
+    for (SubMesh& variant : variants)
+        ::OptimizeVertexCache(&indices[variant.startIndex], &indices[variant.startIndex],
+            variant.indexCount, chunkVertices);
+
+    // ndices locais da pea sempre cabem em 16 bits (peas de at 128 quads)
+    indices16.assign(indices.begin(), indices.end());
+}
+
+// -------------------------------------------------------------------------------
+
+uint Terrain::SelectChunks(vector<SubMesh>& draws, FXMMATRIX worldViewProj,
+    float pixelScale, float maxPixelError, uint maxTriangles) const
+{
+    draws.clear();
+
+    ArenaScope scope(ScratchArena());
+    std::pmr::vector<uint> levels(chunks.size(), 0, &ScratchArena());
+    std::pmr::vector<float> scales(chunks.size(), 0.0f, &ScratchArena());
+    std::pmr::vector<byte> inside(chunks.size(), 0, &ScratchArena());
+
+    MeshletFrustum frustum = ComputeMeshletFrustum(worldViewProj);
+
+    // profundidade (w) cresce ao longo deste vetor: o ponto mais prximo
+    // da esfera fica a radius * |gradiente| antes do centro
+    XMVECTOR wRow = XMVectorSet(
+        XMVectorGetW(worldViewProj.r[0]), XMVectorGetW(worldViewProj.r[1]),
+        XMVectorGetW(worldViewProj.r[2]), 0.0f);
+    float wGradient = XMVectorGetX(XMVector3Length(wRow));
+
+    // ------------------------------------------------------
+    // Pixels por unidade de cada pea na sua profundidade mais
+    // prxima, calculados uma vez para todas as tentativas
+    // ------------------------------------------------------
+
+    for (size_t c = 0; c < chunks.size(); ++c)
+    {
+        const TerrainChunk& chunk = chunks[c];
+
+        XMVECTOR center = XMVectorSetW(XMLoadFloat3(&chunk.sphere.center), 1.0f);
+        float w = XMVectorGetW(XMVector4Transform(center, worldViewProj)) - chunk.sphere.radius * wGradient;
+
+        // pea sobre a cmera ou atrs dela: fica com escala zero e
+        // sempre usa o nvel mais detalhado
+        if (w > 0.0001f)
+            scales[c] = pixelScale / w;
+
+        inside[c] = MeshletVisible(chunk.sphere, frustum);
+    }
+
+    // ------------------------------------------------------
+    // Com oramento, o erro aceito dobra enquanto as peas
+    // visveis passam dele: terrenos maiores ficam mais simples
+    // ao longe e o total de tringulos no cresce com a rea
+    // ------------------------------------------------------
+
+    const uint MaxAttempts = 16;            // o erro aceito cresce no mximo 2^16 vezes
+    float pixelError = maxPixelError;
+
+    for (uint attempt = 0; ; ++attempt)
+    {
+        // nvel mais simples cujo erro na tela no passa do limite
+        for (size_t c = 0; c < chunks.size(); ++c)
+        {
+            if (scales[c] == 0.0f)
+            {
+                levels[c] = 0;
+                continue;
+            }
+
+            uint level = levelCount - 1;
+            while (level > 0 && chunks[c].errors[level] * scales[c] > pixelError)
+                --level;
+
+            levels[c] = level;
+        }
+
+        // vizinhas diferem em no mximo um nvel: duas varreduras
+        // (direta e reversa) propagam min(vizinha + 1) pela grade
+        for (uint r = 0; r < chunkRows; ++r)
+        {
+            for (uint k = 0; k < chunkColumns; ++k)
+            {
+                uint& level = levels[size_t(r) * chunkColumns + k];
+                if (r > 0) level = std::min(level, levels[size_t(r - 1) * chunkColumns + k] + 1);
+                if (k > 0) level = std::min(level, levels[size_t(r) * chunkColumns + k - 1] + 1);
+            }
+        }
+
+        for (uint r = chunkRows; r-- > 0;)
+        {
+            for (uint k = chunkColumns; k-- > 0;)
+            {
+                uint& level = levels[size_t(r) * chunkColumns + k];
+                if (r + 1 < chunkRows) level = std::min(level, levels[size_t(r + 1) * chunkColumns + k] + 1);
+                if (k + 1 < chunkColumns) level = std::min(level, levels[size_t(r) * chunkColumns + k + 1] + 1);
+            }
+        }
+
+        if (maxTriangles == 0 || attempt == MaxAttempts)
+            break;
+
+        // estimativa sem costuras (as costuras s removem tringulos)
+        uint estimate = 0;
+        for (size_t c = 0; c < chunks.size(); ++c)
+            if (inside[c])
+                estimate += Variant(levels[c], 0).indexCount / 3;
+
+        if (estimate <= maxTriangles)
+            break;
+
+        pixelError *= 2.0f;
+    }
+
+    // ------------------------------------------------------
+    // Desenhos das peas visveis, costurando as bordas que
+    // encontram uma vizinha um nvel mais simples
+    // ------------------------------------------------------
+
+    uint triangles = 0;
+
+    for (uint r = 0; r < chunkRows; ++r)
+    {
+        for (uint k = 0; k < chunkColumns; ++k)
+        {
+            size_t c = size_t(r) * chunkColumns + k;
+            if (!inside[c])
+                continue;
+
+            uint level = levels[c];
+            uint mask = 0;
+
+            if (r > 0 && levels[c - chunkColumns] > level) mask |= 1;
+            if (k + 1 < chunkColumns && levels[c + 1] > level) mask |= 2;
+            if (r + 1 < chunkRows && levels[c + chunkColumns] > level) mask |= 4;
+            if (k > 0 && levels[c - 1] > level) mask |= 8;
+
+            SubMesh draw = Variant(level, mask);
+            draw.baseVertex = chunks[c].baseVertex;
+            draws.push_back(draw);
+
+            triangles += draw.indexCount / 3;
+        }
+    }
+
+    return triangles;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,98 @@
+/**********************************************************************************
+// Terrain (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Terreno construdo a partir de um mapa de alturas e dividido em
+//              peas quadradas (geomipmapping). Todas as peas compartilham o
+//              mesmo vertex buffer e uma nica tabela de ndices, gerada a partir
+//              do Grid para cada nvel de detalhe e cada combinao de bordas
+//              costuradas com vizinhos um nvel mais simples. O nvel de cada
+//              pea  escolhido por vista a partir do erro projetado na tela
+//
+**********************************************************************************/
+
+#ifndef DXUT_TERRAIN_H_
+#define DXUT_TERRAIN_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include "Geometry.h"
+#include "Meshlet.h"
+#include <vector>
+#include <DirectXMath.h>
+using namespace DirectX;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+const uint TerrainMaxLevels = 8;            // nveis de detalhe por pea (peas de at 128 quads)
+
+// -------------------------------------------------------------------------------
+
+// amostras de altura dispostas em linhas (eixo z) e colunas (eixo x)
+struct Heightmap
+{
+    uint width = 0;                         // amostras por linha
+    uint depth = 0;                         // nmero de linhas
+    vector<float> heights;                  // alturas (width * depth)
+
+    float At(uint row, uint col) const      // altura da amostra
+    { return heights[size_t(row) * width + col]; }
+};
+
+// gera um mapa de alturas com rudo em vrias frequncias (fBm),
+// com alturas entre 0 e height
+Heightmap GenerateHeightmap(uint width, uint depth, float height, uint seed = 1);
+
+// -------------------------------------------------------------------------------
+
+struct TerrainChunk
+{
+    uint baseVertex = 0;                    // primeiro vrtice da pea no vertex buffer
+    MeshletBounds sphere = {};              // esfera envolvente (sem cone de normais)
+    float errors[TerrainMaxLevels] = {};    // erro geomtrico (altura) de cada nvel
+};
+
+// -------------------------------------------------------------------------------
+// Terrain
+// -------------------------------------------------------------------------------
+
+struct Terrain : public Geometry
+{
+    uint chunkSize = 0;                     // quads por lado de cada pea (potncia de 2)
+    uint chunkColumns = 0;                  // peas ao longo do eixo x
+    uint chunkRows = 0;                     // peas ao longo do eixo z
+    uint levelCount = 0;                    // nveis de detalhe de cada pea
+    vector<TerrainChunk> chunks;            // peas em ordem de linhas
+    vector<SubMesh> variants;               // faixa de ndices de cada nvel e costura
+
+    Terrain(                                // constri as peas do terreno
+        const Heightmap& map,               // mapa de alturas ((chunkSize * k + 1) amostras por lado)
+        float spacing,                      // distncia entre amostras vizinhas
+        uint size = 32);                    // quads por lado de cada pea (potncia de 2)
+
+    // escolhe o nvel de cada pea para uma vista e grava os desenhos das peas
+    // dentro do frustum (baseVertex aponta para a pea); vizinhas diferem em no
+    // mximo um nvel e as bordas so costuradas; com um oramento, o erro aceito
+    // dobra at os tringulos visveis caberem nele; retorna o nmero de tringulos
+    uint SelectChunks(
+        vector<SubMesh>& draws,             // desenhos das peas visveis
+        FXMMATRIX worldViewProj,            // matriz combinada da vista
+        float pixelScale,                   // pixels por unidade  profundidade 1 (escala vertical
+                                            // da projeo vezes metade da altura da viewport)
+        float maxPixelError = 1.0f,         // erro mximo aceito na tela, em pixels
+        uint maxTriangles = 0) const;       // oramento de tringulos da vista (0 = sem limite)
+
+    // faixa de ndices de um nvel com as bordas indicadas costuradas
+    // (bit 0: linha 0, bit 1: ltima coluna, bit 2: ltima linha, bit 3: coluna 0)
+    const SubMesh& Variant(uint level, uint stitchMask) const
+    { return variants[size_t(level) * 16 + stitchMask]; }
+};
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,336 @@
+/**********************************************************************************
+// Transforms (Cdigo Fonte)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Matrizes de mundo dos objetos guardadas em estrutura de arrays:
+//              cada um dos 16 elementos da matriz fica em um vetor contguo e
+//              alinhado. O produto com as matrizes view-projection das vistas
+//               feito em lotes de 4, 8 ou 16 objetos por instruo (SSE, AVX2
+//              ou AVX-512), escolhidos pelo processador em tempo de execuo.
+//              Apenas vistas ativas so calculadas e, quando a matriz da vista
+//              no mudou, apenas os lotes com matrizes de mundo alteradas
+//
+**********************************************************************************/
+
+#include "Transforms.h"
+#include "Simd.h"
+#include "Parallel.h"
+#include <intrin.h>
+#include <cstring>
+#include <algorithm>
+#include <new>
+
+// -------------------------------------------------------------------------------
+
+const uint StreamAlignment = 64;            // alinhamento de cada fluxo (linha de cache, AVX-512)
+const uint StreamGranularity = 16;          // floats por fluxo mltiplo da maior largura SIMD
+const uint ResultStreams = 16 * TransformStore::Views;
+const uint BlockBatches = 64;               // lotes por bloco: 1024 matrizes de mundo (64 KB) lidas
+                                            // uma vez da memria e usadas por todas as vistas
+const uint ParallelBatches = 1024;          // lotes mnimos por thread
+
+// -------------------------------------------------------------------------------
+
+SimdLevels SimdLevel()
+{
+    static const SimdLevels level = []
+    {
+        int info[4];
+
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        bool fma = (info[2] & (1 << 12)) != 0;
+
+        if (!osxsave || !avx || maxLeaf < 7)
+            return SIMD_SSE;
+
+        // o sistema precisa salvar os registradores largos nas trocas de contexto
+        unsigned long long xcr0 = _xgetbv(0);
+        bool ymm = (xcr0 & 0x06) == 0x06;
+        bool zmm = (xcr0 & 0xe6) == 0xe6;
+
+        __cpuidex(info, 7, 0);
+        bool avx2 = (info[1] & (1 << 5)) != 0;
+        bool avx512 = (info[1] & (1 << 16)) != 0;
+
+        if (zmm && avx512)
+            return SIMD_AVX512;
+
+        if (ymm && avx2 && fma)
+            return SIMD_AVX2;
+
+        return SIMD_SSE;
+    }();
+
+    return level;
+}
+
+// -------------------------------------------------------------------------------
+
+// result[i][j] = soma em k de world[i][k] * viewProj[k][j] nas matrizes
+// [begin, end), com os elementos de viewProj repetidos em todas as posies
+// do registrador
+template<class S>
+static void MultiplyStreams(const float* const world[16], const float viewProj[16],
+    float* const result[16], uint begin, uint end)
+{
+    using V = typename S::V;
+
+    for (uint o = begin; o < end; o += S::Width)
+    {
+        for (uint i = 0; i < 4; ++i)
+        {
+            V w0 = S::Load(world[i * 4 + 0] + o);
+            V w1 = S::Load(world[i * 4 + 1] + o);
+            V w2 = S::Load(world[i * 4 + 2] + o);
+            V w3 = S::Load(world[i * 4 + 3] + o);
+
+            for (uint j = 0; j < 4; ++j)
+            {
+                V r = S::Mul(w0, S::Splat(viewProj[0 * 4 + j]));
+                r = S::MulAdd(w1, S::Splat(viewProj[1 * 4 + j]), r);
+                r = S::MulAdd(w2, S::Splat(viewProj[2 * 4 + j]), r);
+                r = S::MulAdd(w3, S::Splat(viewProj[3 * 4 + j]), r);
+
+                S::Store(result[i * 4 + j] + o, r);
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+// percorre os lotes [begin, end) em blocos: as vistas inteiras recalculam o
+// bloco todo, as demais apenas as sequncias de lotes alterados
+template<class S>
+static void ComputeBatches(const float* const world[16], const float viewProj[][16],
+    float* const result[], const bool views[], const bool full[], const byte* changed,
+    uint begin, uint end)
+{
+    for (uint block = begin; block < end; block += BlockBatches)
+    {
+        uint last = (block + BlockBatches < end) ? block + BlockBatches : end;
+
+        for (uint v = 0; v < TransformStore::Views; ++v)
+        {
+            if (!views[v])
+                continue;
+
+            float* const* out = result + v * 16;
+
+            if (full[v])
+            {
+                MultiplyStreams<S>(world, viewProj[v], out, block * StreamGranularity, last * StreamGranularity);
+                continue;
+            }
+
+            for (uint b = block; b < last; ++b)
+            {
+                if (!changed[b])
+                    continue;
+
+                uint run = b;
+                while (run < last && changed[run])
+                    ++run;
+
+                MultiplyStreams<S>(world, viewProj[v], out, b * StreamGranularity, run * StreamGranularity);
+                b = run;
+            }
+        }
+    }
+}
+
+//   ________________
+// _/ TransformStore \___________________________________________________________
+// ------------------------------------------------------------------------------
+
+TransformStore::TransformStore()
+{
+}
+
+// -------------------------------------------------------------------------------
+
+TransformStore::~TransformStore()
+{
+    if (data)
+        ::operator delete(data, std::align_val_t(StreamAlignment));
+}
+
+// -------------------------------------------------------------------------------
+
+void TransformStore::Reserve(uint size)
+{
+    if (size <= capacity)
+        return;
+
+    // cresce em potncias de 2 para que Resize incremental seja amortizado
+    uint newCapacity = capacity ? capacity : StreamGranularity;
+    while (newCapacity < size)
+        newCapacity *= 2;
+
+    size_t bytes = size_t(newCapacity) * (16 + ResultStreams) * sizeof(float);
+    float* newData = static_cast<float*>(::operator new(bytes, std::align_val_t(StreamAlignment)));
+
+    // apenas as matrizes de mundo sobrevivem: resultados so recalculados;
+    // o espao novo  a identidade, de forma que os lotes SIMD sempre leem 
+    // valores vlidos alm da ltima matriz
+    for (uint s = 0; s < 16; ++s)
+    {
+        float* stream = newData + size_t(s) * newCapacity;
+        if (data)
+            memcpy(stream, Stream(s), size_t(count) * sizeof(float));
+
+        float value = (s % 5 == 0) ? 1.0f : 0.0f;
+        for (uint i = count; i < newCapacity; ++i)
+            stream[i] = value;
+    }
+
+    if (data)
+        ::operator delete(data, std::align_val_t(StreamAlignment));
+
+    data = newData;
+    capacity = newCapacity;
+    changed.resize(capacity / StreamGranularity, 0);
+
+    for (uint v = 0; v < Views; ++v)
+        valid[v] = false;
+}
+
+// -------------------------------------------------------------------------------
+
+void TransformStore::Resize(uint size)
+{
+    Reserve(size);
+
+    // apenas as novas matrizes so escritas (identidade): o restante do fluxo
+    // j tem valores vlidos, da alocao ou de matrizes removidas
+    for (uint s = 0; s < 16; ++s)
+    {
+        float value = (s % 5 == 0) ? 1.0f : 0.0f;
+        float* stream = Stream(s);
+
+        for (uint i = count; i < size; ++i)
+            stream[i] = value;
+    }
+
+    // lotes das novas matrizes precisam de resultados
+    for (uint i = count; i < size; i += StreamGranularity)
+        changed[i / StreamGranularity] = 1;
+
+    if (size > count)
+        changed[(size - 1) / StreamGranularity] = 1;
+
+    count = size;
+}
+
+// -------------------------------------------------------------------------------
+
+void TransformStore::Erase(uint index)
+{
+    uint last = count - 1;
+
+    if (index != last)
+    {
+        for (uint s = 0; s < 16; ++s)
+            Stream(s)[index] = Stream(s)[last];
+
+        changed[index / StreamGranularity] = 1;
+    }
+
+    count = last;
+}
+
+// -------------------------------------------------------------------------------
+
+void TransformStore::Set(uint index, FXMMATRIX world)
+{
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, world);
+
+    for (uint s = 0; s < 16; ++s)
+        Stream(s)[index] = m.m[s / 4][s % 4];
+
+    changed[index / StreamGranularity] = 1;
+}
+
+// -------------------------------------------------------------------------------
+
+XMMATRIX TransformStore::World(uint index) const
+{
+    XMFLOAT4X4 m;
+    for (uint s = 0; s < 16; ++s)
+        m.m[s / 4][s % 4] = Stream(s)[index];
+
+    return XMLoadFloat4x4(&m);
+}
+
+// -------------------------------------------------------------------------------
+
+void TransformStore::Compute(const XMMATRIX viewProj[Views], const bool active[Views])
+{
+    const float* world[16];
+    float* result[ResultStreams];
+    float matrices[Views][16];
+    bool full[Views];
+
+    for (uint s = 0; s < 16; ++s)
+        world[s] = Stream(s);
+
+    for (uint s = 0; s < ResultStreams; ++s)
+        result[s] = Stream(16 + s);
+
+    // uma vista  recalculada por inteiro quando a sua matriz mudou ou quando
+    // os seus resultados ficaram para trs enquanto estava inativa
+    for (uint v = 0; v < Views; ++v)
+    {
+        XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(matrices[v]), viewProj[v]);
+
+        if (!active[v])
+        {
+            valid[v] = false;
+            full[v] = false;
+            continue;
+        }
+
+        full[v] = !valid[v] || memcmp(matrices[v], &computed[v], sizeof(XMFLOAT4X4)) != 0;
+        memcpy(&computed[v], matrices[v], sizeof(XMFLOAT4X4));
+        valid[v] = true;
+    }
+
+    // o fluxo tem capacidade mltipla de 16: o ltimo lote pode passar de count
+    uint batches = (count + StreamGranularity - 1) / StreamGranularity;
+    const byte* flags = changed.data();
+    SimdLevels level = SimdLevel();
+
+    ParallelFor(batches, ParallelBatches, [&](uint begin, uint end)
+    {
+        switch (level)
+        {
+        case SIMD_AVX512: ComputeBatches<SimdAvx512>(world, matrices, result, active, full, flags, begin, end); break;
+        case SIMD_AVX2:   ComputeBatches<SimdAvx2>(world, matrices, result, active, full, flags, begin, end); break;
+        default:          ComputeBatches<SimdSse>(world, matrices, result, active, full, flags, begin, end); break;
+        }
+    });
+
+    std::fill(changed.begin(), changed.end(), byte(0));
+}
+
+// -------------------------------------------------------------------------------
+
+XMMATRIX TransformStore::WorldViewProj(uint view, uint index) const
+{
+    XMFLOAT4X4 m;
+    for (uint s = 0; s < 16; ++s)
+        m.m[s / 4][s % 4] = Stream(16 + view * 16 + s)[index];
+
+    return XMLoadFloat4x4(&m);
+}
+
+// -------------------------------------------------------------------------------
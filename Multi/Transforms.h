@@ -0,0 +1,86 @@
+/**********************************************************************************
+// Transforms (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Matrizes de mundo dos objetos guardadas em estrutura de arrays:
+//              cada um dos 16 elementos da matriz fica em um vetor contguo e
+//              alinhado. O produto com as matrizes view-projection das vistas
+//               feito em lotes de 4, 8 ou 16 objetos por instruo (SSE, AVX2
+//              ou AVX-512), escolhidos pelo processador em tempo de execuo.
+//              Apenas vistas ativas so calculadas e, quando a matriz da vista
+//              no mudou, apenas os lotes com matrizes de mundo alteradas
+//
+**********************************************************************************/
+
+#ifndef DXUT_TRANSFORMS_H_
+#define DXUT_TRANSFORMS_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <vector>
+#include <DirectXMath.h>
+using namespace DirectX;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+enum SimdLevels
+{
+    SIMD_SSE,                               // 4 floats por instruo
+    SIMD_AVX2,                              // 8 floats por instruo (com FMA)
+    SIMD_AVX512                             // 16 floats por instruo
+};
+
+// conjunto de instrues mais largo suportado pelo processador e pelo sistema
+SimdLevels SimdLevel();
+
+// -------------------------------------------------------------------------------
+
+class TransformStore
+{
+public:
+    static const uint Views = 4;            // vistas calculadas por Compute
+
+private:
+    float* data = nullptr;                  // fluxos de mundo (16) seguidos dos resultados (16 por vista)
+    uint count = 0;                         // matrizes em uso
+    uint capacity = 0;                      // floats por fluxo (mltiplo de 16)
+    vector<byte> changed;                   // lote de 16 matrizes alterado desde o ltimo Compute
+    XMFLOAT4X4 computed[Views];             // matriz de cada vista no ltimo Compute
+    bool valid[Views] = {};                 // resultados da vista correspondem a computed
+
+    float* Stream(uint s) const             // incio de um fluxo
+    { return data + size_t(s) * capacity; }
+
+    void Reserve(uint size);                // garante espao para size matrizes
+
+public:
+    TransformStore();                       // construtor
+    ~TransformStore();                      // destrutor
+
+    TransformStore(const TransformStore&) = delete;
+    TransformStore& operator=(const TransformStore&) = delete;
+
+    void Resize(uint size);                 // ajusta nmero de matrizes (novas so a identidade)
+    void Erase(uint index);                 // remove movendo a ltima matriz para o lugar (como o SlotMap)
+    void Set(uint index, FXMMATRIX world);  // altera matriz de mundo
+    XMMATRIX World(uint index) const;       // l matriz de mundo
+
+    // calcula world x viewProj[v] nas vistas ativas: todas as matrizes quando
+    // a vista mudou ou estava inativa, apenas os lotes alterados caso contrrio
+    void Compute(const XMMATRIX viewProj[Views], const bool active[Views]);
+
+    // resultado de Compute para uma matriz e uma vista
+    XMMATRIX WorldViewProj(uint view, uint index) const;
+
+    uint Count() const                      // nmero de matrizes
+    { return count; }
+};
+
+// -------------------------------------------------------------------------------
+
+#endif
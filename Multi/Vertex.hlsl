@@ -6,20 +6,38 @@
 // Compilador:  Direct3D Shader Compiler (FXC)
 //
 // Descrio:   Um vertex shader que faz a transformao de vrtices
-//              a partir de uma matriz combinada WorldViewProj fornecida
+//              a partir da matriz de mundo do objeto e da matriz
+//              view-projection da vista
 //
 **********************************************************************************/
 
-cbuffer Object
+// constantes do objeto, iguais em todas as vistas
+cbuffer Object : register(b0)
 {
-    float4x4 WorldViewProj;
+    float4x4 World;
     float4 objColor;
 };
 
+// constantes da vista (constantes raiz)
+cbuffer View : register(b1)
+{
+    float4x4 ViewProj;
+};
+
+// atributos lidos pelo shader, verificados contra o tipo de vrtice no C++
+#include "VertexInput.h"
+
+// a posio pode chegar quantizada (16 bits normalizados ou meia preciso);
+// a matriz World j inclui a volta ao espao do objeto
 struct VertexIn
 {
-    float3 PosL  : POSITION;
-    float4 Color : COLOR;
+    float3 PosL    : POSITION;
+#if VERTEX_INPUT_COLOR
+    float4 Color   : COLOR;
+#endif
+#if VERTEX_INPUT_NORMAL
+    float3 NormalL : NORMAL;
+#endif
 };
 
 struct VertexOut
@@ -33,7 +51,7 @@ VertexOut main(VertexIn vin)
     VertexOut vout;
 
     // transforma para espao homogneo de recorte
-    vout.PosH = mul(float4(vin.PosL, 1.0f), WorldViewProj);
+    vout.PosH = mul(mul(float4(vin.PosL, 1.0f), World), ViewProj);
 
     // apenas passa a cor do vrtice para o pixel shader
     //vout.Color = vin.Color;
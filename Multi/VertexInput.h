@@ -0,0 +1,46 @@
+/**********************************************************************************
+// VertexInput (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022 e Direct3D Shader Compiler (FXC)
+//
+// Descrio:   Atributos lidos pelo vertex shader, compartilhados entre o HLSL
+//              e o C++. Vertex.hlsl monta a sua estrutura de entrada a partir
+//              destas definies e o C++ verifica, em tempo de compilao, que
+//              o tipo de vrtice enviado  GPU fornece cada uma delas: um
+//              atributo lido pelo shader e ausente no input layout no compila,
+//              em vez de falhar na criao do pipeline
+//
+**********************************************************************************/
+
+#ifndef DXUT_VERTEXINPUT_H_
+#define DXUT_VERTEXINPUT_H_
+
+// -------------------------------------------------------------------------------
+
+// atributos lidos pelo vertex shader alm da posio (0 ou 1)
+#define VERTEX_INPUT_COLOR  1
+#define VERTEX_INPUT_NORMAL 1
+
+// -------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+#include "VertexTypes.h"
+
+// o tipo de vrtice fornece todos os atributos que o vertex shader l
+// (atributos a mais no input layout so ignorados pelo pipeline)
+template<class V>
+struct ShaderAccepts
+{
+    static constexpr bool value =
+        (!VERTEX_INPUT_COLOR || VertexDescriptor<V>::hasColor) &&
+        (!VERTEX_INPUT_NORMAL || VertexDescriptor<V>::hasNormal);
+};
+
+#endif
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,169 @@
+/**********************************************************************************
+// VertexTypes (Arquivo de Cabealho)
+//
+// Criao:     19 Out 2026
+// Atualizao: 19 Out 2026
+// Compilador:  Visual C++ 2022
+//
+// Descrio:   Tipos de vrtice e o descritor de cada um, gerado em tempo de
+//              compilao a partir dos membros declarados (pos, color, normal).
+//              O descritor fornece o tamanho, os atributos do input layout e a
+//              converso a partir do vrtice completo usado no processamento;
+//              tipos ou atributos desconhecidos no compilam
+//
+**********************************************************************************/
+
+#ifndef DXUT_VERTEXTYPES_H_
+#define DXUT_VERTEXTYPES_H_
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <dxgiformat.h>
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+using namespace DirectX;
+
+// -------------------------------------------------------------------------------
+
+// vrtice completo usado na gerao e no processamento das malhas (40 bytes)
+struct Vertex
+{
+    XMFLOAT3 pos;
+    XMFLOAT4 color;
+    XMFLOAT3 normal;
+};
+
+// posio em 16 bits normalizados na caixa envolvente, cor e normal em 8 bits (16 bytes)
+struct QuantizedVertex
+{
+    PackedVector::XMSHORTN4 pos;
+    PackedVector::XMUBYTEN4 color;
+    PackedVector::XMBYTEN4 normal;
+};
+
+// posio em meia preciso na caixa envolvente, cor e normal em 8 bits (16 bytes)
+struct HalfVertex
+{
+    PackedVector::XMHALF4 pos;
+    PackedVector::XMUBYTEN4 color;
+    PackedVector::XMBYTEN4 normal;
+};
+
+// apenas a posio, para passagens de profundidade (8 bytes)
+struct PositionVertex
+{
+    PackedVector::XMSHORTN4 pos;
+};
+
+// -------------------------------------------------------------------------------
+
+// atributo de um tipo de vrtice no input layout
+struct VertexAttribute
+{
+    const char* semantic;                   // semntica no vertex shader
+    DXGI_FORMAT format;                     // formato lido pelo input assembler
+    uint offset;                            // deslocamento em bytes dentro do vrtice
+};
+
+// formato de cada tipo de atributo (sem especializao, o tipo no compila)
+template<class T> struct AttributeFormat;
+template<> struct AttributeFormat<XMFLOAT3>  { static constexpr DXGI_FORMAT value = DXGI_FORMAT_R32G32B32_FLOAT; };
+template<> struct AttributeFormat<XMFLOAT4>  { static constexpr DXGI_FORMAT value = DXGI_FORMAT_R32G32B32A32_FLOAT; };
+template<> struct AttributeFormat<PackedVector::XMSHORTN4> { static constexpr DXGI_FORMAT value = DXGI_FORMAT_R16G16B16A16_SNORM; };
+template<> struct AttributeFormat<PackedVector::XMHALF4>   { static constexpr DXGI_FORMAT value = DXGI_FORMAT_R16G16B16A16_FLOAT; };
+template<> struct AttributeFormat<PackedVector::XMUBYTEN4> { static constexpr DXGI_FORMAT value = DXGI_FORMAT_R8G8B8A8_UNORM; };
+template<> struct AttributeFormat<PackedVector::XMBYTEN4>  { static constexpr DXGI_FORMAT value = DXGI_FORMAT_R8G8B8A8_SNORM; };
+
+// deteco dos atributos opcionais
+template<class V, class = void> struct HasColor : std::false_type {};
+template<class V> struct HasColor<V, std::void_t<decltype(V::color)>> : std::true_type {};
+
+template<class V, class = void> struct HasNormal : std::false_type {};
+template<class V> struct HasNormal<V, std::void_t<decltype(V::normal)>> : std::true_type {};
+
+// -------------------------------------------------------------------------------
+
+// converso de cada tipo de atributo
+inline void StoreAttribute(XMFLOAT3& out, FXMVECTOR v)  { XMStoreFloat3(&out, v); }
+inline void StoreAttribute(XMFLOAT4& out, FXMVECTOR v)  { XMStoreFloat4(&out, v); }
+inline void StoreAttribute(PackedVector::XMSHORTN4& out, FXMVECTOR v) { PackedVector::XMStoreShortN4(&out, v); }
+inline void StoreAttribute(PackedVector::XMHALF4& out, FXMVECTOR v)   { PackedVector::XMStoreHalf4(&out, v); }
+inline void StoreAttribute(PackedVector::XMUBYTEN4& out, FXMVECTOR v) { PackedVector::XMStoreUByteN4(&out, v); }
+inline void StoreAttribute(PackedVector::XMBYTEN4& out, FXMVECTOR v)  { PackedVector::XMStoreByteN4(&out, v); }
+
+// -------------------------------------------------------------------------------
+
+template<class V>
+struct VertexDescriptor
+{
+    using PositionType = decltype(V::pos);
+
+    static constexpr bool hasColor = HasColor<V>::value;
+    static constexpr bool hasNormal = HasNormal<V>::value;
+    static constexpr uint count = 1 + hasColor + hasNormal;
+    static constexpr uint stride = uint(sizeof(V));
+    static constexpr uint positionSize = uint(sizeof(PositionType));
+
+    // posies fora de float so normalizadas na caixa envolvente da malha
+    static constexpr bool quantized = !std::is_same_v<PositionType, XMFLOAT3>;
+
+    static constexpr uint ColorSize()
+    {
+        if constexpr (hasColor) return uint(sizeof(V::color)); else return 0;
+    }
+
+    static constexpr uint NormalSize()
+    {
+        if constexpr (hasNormal) return uint(sizeof(V::normal)); else return 0;
+    }
+
+    // a posio abre o vrtice e no h preenchimento entre atributos, de forma
+    // que o vrtice pode ser dividido em um fluxo de posies e outro de atributos
+    static_assert(offsetof(V, pos) == 0, "a posio deve ser o primeiro membro do vrtice");
+    static_assert(positionSize + ColorSize() + NormalSize() == stride, "o vrtice no pode ter preenchimento");
+
+    // atributos na ordem em que aparecem no vrtice
+    static std::array<VertexAttribute, count> Attributes()
+    {
+        std::array<VertexAttribute, count> attributes = {};
+        uint i = 0;
+
+        attributes[i++] = { "POSITION", AttributeFormat<PositionType>::value, 0 };
+
+        if constexpr (hasColor)
+            attributes[i++] = { "COLOR", AttributeFormat<decltype(V::color)>::value, uint(offsetof(V, color)) };
+
+        if constexpr (hasNormal)
+            attributes[i++] = { "NORMAL", AttributeFormat<decltype(V::normal)>::value, uint(offsetof(V, normal)) };
+
+        return attributes;
+    }
+
+    // converte o vrtice completo escrevendo apenas os atributos declarados
+    static V Encode(const Vertex& source, FXMVECTOR center, FXMVECTOR inverseExtent)
+    {
+        V v;
+
+        XMVECTOR p = XMLoadFloat3(&source.pos);
+        if constexpr (quantized)
+            p = XMVectorSetW((p - center) * inverseExtent, 1.0f);
+
+        StoreAttribute(v.pos, p);
+
+        if constexpr (hasColor)
+            StoreAttribute(v.color, XMLoadFloat4(&source.color));
+
+        if constexpr (hasNormal)
+            StoreAttribute(v.normal, XMLoadFloat3(&source.normal));
+
+        return v;
+    }
+};
+
+// -------------------------------------------------------------------------------
+
+#endif